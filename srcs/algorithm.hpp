@@ -1,5 +1,7 @@
 #pragma once
 
+#include <memory>
+
 #include "iterators.hpp"
 #include "iterators_traits.hpp"
 
@@ -29,6 +31,17 @@ namespace ft {
         }
     };
 
+    /* Transparent less: compares any two types that have operator< */
+    template<>
+    struct less<void> {
+        typedef void is_transparent;
+
+        template<class T, class U>
+        bool operator()(const T& lhs, const U& rhs) const {
+            return (lhs < rhs);
+        }
+    };
+
     /* lexicographical_compare */
     template< class InputIt1, class InputIt2 >
     bool lexicographical_compare( InputIt1 first1, InputIt1 last1,
@@ -90,6 +103,79 @@ namespace ft {
         return (size1 == size2);
     }
 
+    /* stable_sort */
+    template<class RandomIt, class Compare>
+    void _insertion_sort(RandomIt first, RandomIt last, Compare comp) {
+        typedef typename iterator_traits<RandomIt>::value_type value_type;
+        if (first == last) {
+            return;
+        }
+        for (RandomIt it = first + 1; it < last; ++it) {
+            value_type temp = *it;
+            RandomIt hole = it;
+            for (; hole > first && comp(temp, *(hole - 1)); --hole) {
+                *hole = *(hole - 1);
+            }
+            *hole = temp;
+        }
+    }
+
+    /* Merges [first, middle) and [middle, last) through buffer, which has room for middle - first elements */
+    template<class RandomIt, class T, class Compare>
+    void _merge_adjacent(RandomIt first, RandomIt middle, RandomIt last, T* buffer, Compare comp) {
+        std::allocator<T> allocator;
+        T* buffer_end = buffer;
+        for (RandomIt it = first; it < middle; ++it, ++buffer_end) {
+            allocator.construct(buffer_end, *it);
+        }
+        T* left = buffer;
+        RandomIt out = first;
+        for (; left != buffer_end && middle < last; ++out) {
+            if (comp(*middle, *left)) {
+                *out = *middle;
+                ++middle;
+            } else {
+                *out = *left;
+                ++left;
+            }
+        }
+        for (; left != buffer_end; ++left, ++out) {
+            *out = *left;
+        }
+        for (T* it = buffer; it != buffer_end; ++it) {
+            allocator.destroy(it);
+        }
+    }
+
+    /* Bottom-up merge sort. Neighbouring runs that are already in order are
+     * not merged, so sorted input costs n - 1 comparisons per pass. */
+    template<class RandomIt, class Compare>
+    void stable_sort(RandomIt first, RandomIt last, Compare comp) {
+        typedef typename iterator_traits<RandomIt>::value_type value_type;
+        typedef typename iterator_traits<RandomIt>::difference_type difference_type;
+        const difference_type run = 16;
+        difference_type size = last - first;
+
+        for (difference_type i = 0; i < size; i += run) {
+            _insertion_sort(first + i, first + (size - i > run ? i + run : size), comp);
+        }
+        if (size <= run) {
+            return;
+        }
+        std::allocator<value_type> allocator;
+        value_type* buffer = allocator.allocate(size);
+        for (difference_type width = run; width < size; width *= 2) {
+            for (difference_type i = 0; i + width < size; i += 2 * width) {
+                RandomIt middle = first + (i + width);
+                if (comp(*middle, *(middle - 1))) {
+                    RandomIt end = first + (size - i > 2 * width ? i + 2 * width : size);
+                    _merge_adjacent(first + i, middle, end, buffer, comp);
+                }
+            }
+        }
+        allocator.deallocate(buffer, size);
+    }
+
     /* is_integral */
     template<class T, bool v>
     struct integral_constant {
@@ -113,8 +199,28 @@ namespace ft {
     template<> struct is_integral<unsigned long> : public integral_constant<unsigned long, true> {};
     template<> struct is_integral<unsigned long long> : public integral_constant<unsigned long long, true> {};
 
+    /* is_trivially_destructible */
+    template<class T>
+    struct is_trivially_destructible : public integral_constant<bool, __has_trivial_destructor(T)> {};
+
+    /* is_trivially_copyable: safe to copy as raw bytes */
+    template<class T>
+    struct is_trivially_copyable : public integral_constant<bool, __has_trivial_copy(T) && __has_trivial_assign(T)
+                                                                  && __has_trivial_destructor(T)> {};
+
     /* enable_if */
     template<bool B, class T = void> struct enable_if {};
     template<class T> struct enable_if<true, T> { typedef T type; };
 
+    /* is_transparent: true if Compare declares is_transparent, i.e. accepts heterogeneous keys */
+    template<class Compare>
+    struct is_transparent {
+    private:
+        template<class U> static char _test(typename U::is_transparent*);
+        template<class U> static long _test(...);
+
+    public:
+        static const bool value = (sizeof(_test<Compare>(0)) == sizeof(char));
+    };
+
 } //namespace ft
@@ -0,0 +1,882 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+
+#include "iterators.hpp"
+#include "iterators_traits.hpp"
+#include "algorithm.hpp"
+#include "pair.hpp"
+
+namespace ft {
+
+    /* B-tree node: up to Slots values kept sorted in place. Leaves stop
+     * here, inner nodes add Slots + 1 children. Every node knows its
+     * position among its parent's children. */
+    template<class U, size_t Slots>
+    struct _btree_node {
+        typedef U value_type;
+
+        _btree_node* parent;
+        unsigned short position;
+        unsigned short count;
+        bool leaf;
+        union {
+            char bytes[Slots * sizeof(U)];
+            long double align_ld;
+            long long align_ll;
+            void* align_p;
+        } storage;
+
+        value_type& value(size_t i) {
+            return reinterpret_cast<value_type*>(storage.bytes)[i];
+        }
+    };
+
+    template<class U, size_t Slots>
+    struct _btree_inner : public _btree_node<U, Slots> {
+        typedef _btree_node<U, Slots> node_type;
+
+        node_type* children[Slots + 1];
+    };
+
+    /* B-tree iterator: a node and a value index in it. end() is index 0 of
+     * the header, an empty inner node whose only child is the root. */
+    template<class Inner, typename T>
+    class BTreeIter : iterator<T, ft::bidirectional_iterator_tag> {
+    public:
+        typedef ft::bidirectional_iterator_tag iterator_category;
+        typedef typename ft::iterator_traits<T*>::value_type 		value_type;
+        typedef typename ft::iterator_traits<T*>::pointer			pointer;
+        typedef typename ft::iterator_traits<T*>::reference 		reference;
+        typedef typename ft::iterator_traits<T*>::difference_type	difference_type;
+        typedef typename Inner::node_type* node_pointer;
+
+    public:
+        BTreeIter() : _pnode(nullptr), _index(0) {
+        }
+
+        BTreeIter(node_pointer pnode, size_t index) : _pnode(pnode), _index(index) {
+        }
+
+        BTreeIter(const BTreeIter& other) : _pnode(other._pnode), _index(other._index) {
+        }
+
+        BTreeIter& operator=(const BTreeIter& other) {
+            if (this != &other) {
+                _pnode = other._pnode;
+                _index = other._index;
+            }
+            return *this;
+        }
+
+    public:
+        node_pointer base() const {
+            return _pnode;
+        }
+
+        size_t index() const {
+            return _index;
+        }
+
+        reference operator*() const {
+            return _pnode->value(_index);
+        }
+
+        pointer operator->() const {
+            return &(_pnode->value(_index));
+        }
+
+        BTreeIter& operator++() {
+            if (!_pnode->leaf) {
+                _pnode = _child(_pnode, _index + 1);
+                while (!_pnode->leaf) {
+                    _pnode = _child(_pnode, 0);
+                }
+                _index = 0;
+                return *this;
+            }
+            ++_index;
+            while (_index == _pnode->count && _pnode->parent) {
+                _index = _pnode->position;
+                _pnode = _pnode->parent;
+            }
+            return *this;
+        }
+
+        BTreeIter operator++(int) {
+            BTreeIter temp(*this);
+            ++(*this);
+            return temp;
+        }
+
+        BTreeIter& operator--() {
+            if (!_pnode->leaf) {
+                _pnode = _child(_pnode, _index);
+                while (!_pnode->leaf) {
+                    _pnode = _child(_pnode, _pnode->count);
+                }
+                _index = _pnode->count - 1;
+                return *this;
+            }
+            if (_index > 0) {
+                --_index;
+                return *this;
+            }
+            while (_pnode->parent && _pnode->position == 0) {
+                _pnode = _pnode->parent;
+            }
+            _index = _pnode->position - 1;
+            _pnode = _pnode->parent;
+            return *this;
+        }
+
+        BTreeIter operator--(int) {
+            BTreeIter temp(*this);
+            --(*this);
+            return temp;
+        }
+
+    private:
+        static node_pointer _child(node_pointer pnode, size_t index) {
+            return static_cast<Inner*>(pnode)->children[index];
+        }
+
+    private:
+        node_pointer _pnode;
+        size_t _index;
+    };
+
+    template<class I, class U>
+    bool operator==(const BTreeIter<I, U>& lhs, const BTreeIter<I, U>& rhs) {
+        return (lhs.base() == rhs.base() && lhs.index() == rhs.index());
+    }
+
+    template<class I, class U>
+    bool operator!=(const BTreeIter<I, U>& lhs, const BTreeIter<I, U>& rhs) {
+        return !(lhs == rhs);
+    }
+
+    /* B-tree with nodes of about NodeBytes bytes, so a lookup touches one
+     * node per level instead of one per comparison. Values move between
+     * nodes as they fill and empty: insert and erase invalidate every
+     * iterator except end(). */
+    template<class Value, class Compare = std::less<Value>, class Alloc = std::allocator<Value>, size_t NodeBytes = 256>
+    class BTree {
+    private:
+        enum {
+            _node_fields = sizeof(void*) + 2 * sizeof(unsigned short) + sizeof(bool),
+            _fit = (NodeBytes > _node_fields ? (NodeBytes - _node_fields) / sizeof(Value) : 0),
+            _slots = (_fit < 3 ? 3 : (_fit > 1024 ? 1024 : _fit)),
+            _min_count = _slots / 2
+        };
+
+    public:
+        typedef Value value_type;
+        typedef Alloc allocator_type;
+        typedef Compare compare_type;
+        typedef _btree_node<Value, _slots> node_type;
+        typedef _btree_inner<Value, _slots> inner_type;
+
+        typedef typename allocator_type::template rebind<node_type>::other leaf_allocator;
+        typedef typename allocator_type::template rebind<inner_type>::other inner_allocator;
+
+        typedef typename allocator_type::difference_type difference_type;
+        typedef typename allocator_type::size_type size_type;
+        typedef node_type* node_pointer;
+        typedef BTreeIter<inner_type, value_type> iterator;
+        typedef BTreeIter<inner_type, const value_type> const_iterator;
+        typedef ft::reverse_iterator<iterator> reverse_iterator;
+        typedef ft::reverse_iterator<const_iterator> const_reverse_iterator;
+
+        /* Values are packed in leaves, there are no nodes to hand out */
+        struct node_handle {
+        };
+
+        /* No augmentations, no aggregates */
+        typedef void aggregate_type;
+
+        void refresh(iterator) {
+        }
+
+        /* Place for a new value: index in a leaf, or an empty tree if node is nullptr */
+        struct slot_type {
+            node_pointer node;
+            size_type index;
+        };
+
+    private:
+        /* Position of a value while values move around during erase */
+        struct _cursor {
+            node_pointer node;
+            size_type index;
+        };
+
+    public:
+        BTree(const compare_type& cmp, const allocator_type& allocator = allocator_type())
+                : _allocator(allocator), _leaf_allocator(allocator), _inner_allocator(allocator), _cmp(cmp), _size(0) {
+            _header = _new_node(false);
+            _set_child(_header, 0, nullptr);
+        }
+
+        BTree(const BTree& other)
+                : _allocator(other._allocator), _leaf_allocator(other._leaf_allocator), _inner_allocator(other._inner_allocator),
+                  _cmp(other._cmp), _size(0) {
+            _header = _new_node(false);
+            _set_child(_header, 0, nullptr);
+            _clone(other);
+        }
+
+        BTree& operator=(const BTree& other) {
+            if (this != &other) {
+                _cmp = other._cmp;
+                clear();
+                _clone(other);
+            }
+            return *this;
+        }
+
+        ~BTree() {
+            clear();
+            _delete_node(_header);
+        }
+
+    /* iterators */
+    public:
+        iterator begin() {
+            return iterator(_begin(), 0);
+        }
+
+        const_iterator begin() const {
+            return const_iterator(_begin(), 0);
+        }
+
+        iterator end() {
+            return iterator(_header, 0);
+        }
+
+        const_iterator end() const {
+            return const_iterator(_header, 0);
+        }
+
+        reverse_iterator rbegin() {
+            return reverse_iterator(end());
+        }
+
+        const_reverse_iterator rbegin() const {
+            return const_reverse_iterator(end());
+        }
+
+        reverse_iterator rend() {
+            return reverse_iterator(begin());
+        }
+
+        const_reverse_iterator rend() const {
+            return const_reverse_iterator(begin());
+        }
+
+    /* Capacity */
+    public:
+        size_type size() const {
+            return _size;
+        }
+
+    /* Modifiers */
+    public:
+        void clear() {
+            if (_root()) {
+                _delete_subtree(_root());
+                _set_child(_header, 0, nullptr);
+                _size = 0;
+            }
+        }
+
+        ft::pair<iterator, bool> insert(const value_type& value) {
+            slot_type slot;
+            _cursor found = _locate(value, slot);
+            if (found.node) {
+                return ft::make_pair(iterator(found.node, found.index), false);
+            } else {
+                return ft::make_pair(insert_at(slot, value), true);
+            }
+        }
+
+        /* Same contract as Treap::locate() */
+        template<class K>
+        iterator locate(const K& key, slot_type& slot) {
+            _cursor found = _locate(key, slot);
+            return (found.node ? iterator(found.node, found.index) : end());
+        }
+
+        /* Puts value into the leaf slot, splitting full nodes on the way up */
+        iterator insert_at(const slot_type& slot, const value_type& value) {
+            node_pointer pnode = slot.node;
+            size_type index = slot.index;
+            if (!pnode) {
+                pnode = _new_node(true);
+                _set_child(_header, 0, pnode);
+                index = 0;
+            } else if (pnode->count == _slots) {
+                _split(pnode, index);
+                if (index > pnode->count) {
+                    index -= pnode->count + 1;
+                    pnode = _child(pnode->parent, pnode->position + 1);
+                }
+            }
+            _shift_right(pnode, index);
+            _allocator.construct(&pnode->value(index), value);
+            ++pnode->count;
+            ++_size;
+            return iterator(pnode, index);
+        }
+
+        /* Replaces the contents with [first, last), keeping the first of equal
+         * values. Sorted input is appended at the right edge in O(1) per value. */
+        template<class InputIt>
+        void assign(InputIt first, InputIt last) {
+            clear();
+            for (; first != last; ++first) {
+                insert(end(), *first);
+            }
+        }
+
+        iterator insert(iterator hint, const value_type& value) {
+            if (_size == 0) {
+                return insert(value).first;
+            }
+            if (hint == end()) {
+                iterator prev = hint;
+                --prev;
+                if (_cmp(*prev, value)) {
+                    return insert_at(_slot_after(prev), value);
+                }
+            } else if (_cmp(value, *hint)) {
+                iterator prev = hint;
+                if (hint == begin() || _cmp(*(--prev), value)) {
+                    return insert_at(_slot_before(hint), value);
+                }
+            } else if (_cmp(*hint, value)) {
+                iterator next = hint;
+                ++next;
+                if (next == end() || _cmp(value, *next)) {
+                    return insert_at(_slot_after(hint), value);
+                }
+            } else {
+                return hint;
+            }
+            return insert(value).first;
+        }
+
+        /* Removes the value at pos: an inner value is replaced by its
+         * successor, then the leaf refills from a sibling or merges with it.
+         * Returns the position of the following value after all moves. */
+        iterator erase(iterator pos) {
+            if (pos == end()) {
+                return pos;
+            }
+            node_pointer pnode = pos.base();
+            size_type index = pos.index();
+            _cursor next = { pnode, index };
+            _allocator.destroy(&pnode->value(index));
+            if (!pnode->leaf) {
+                node_pointer leaf = _child(pnode, index + 1);
+                while (!leaf->leaf) {
+                    leaf = _child(leaf, 0);
+                }
+                _move_value(pnode, index, leaf, 0);
+                pnode = leaf;
+                index = 0;
+            }
+            _shift_left(pnode, index);
+            --pnode->count;
+            --_size;
+            _rebalance(pnode, next);
+            return _normalize(next);
+        }
+
+        iterator erase(iterator first, iterator last) {
+            if (first == begin() && last == end()) {
+                clear();
+                return end();
+            }
+            for (difference_type count = ft::distance(first, last); count > 0; --count) {
+                first = erase(first);
+            }
+            return first;
+        }
+
+        void swap(BTree& other) {
+            ft::swap(_allocator, other._allocator);
+            ft::swap(_leaf_allocator, other._leaf_allocator);
+            ft::swap(_inner_allocator, other._inner_allocator);
+            ft::swap(_cmp, other._cmp);
+            ft::swap(_header, other._header);
+            ft::swap(_size, other._size);
+        }
+
+    /* Lookup */
+    public:
+        template<class K>
+        iterator find(const K& key) {
+            _cursor found = _search(key);
+            return iterator(found.node, found.index);
+        }
+
+        template<class K>
+        const_iterator find(const K& key) const {
+            _cursor found = _search(key);
+            return const_iterator(found.node, found.index);
+        }
+
+        template<class K>
+        iterator lower_bound(const K& key) {
+            _cursor bound = _lower_bound(key);
+            return iterator(bound.node, bound.index);
+        }
+
+        template<class K>
+        const_iterator lower_bound(const K& key) const {
+            _cursor bound = _lower_bound(key);
+            return const_iterator(bound.node, bound.index);
+        }
+
+        template<class K>
+        iterator upper_bound(const K& key) {
+            _cursor bound = _upper_bound(key);
+            return iterator(bound.node, bound.index);
+        }
+
+        template<class K>
+        const_iterator upper_bound(const K& key) const {
+            _cursor bound = _upper_bound(key);
+            return const_iterator(bound.node, bound.index);
+        }
+
+    /* Observers */
+    public:
+        compare_type value_comp() {
+            return _cmp;
+        }
+
+    /* private helpers */
+    private:
+        node_pointer _root() const {
+            return _child(_header, 0);
+        }
+
+        node_pointer _begin() const {
+            node_pointer pnode = _root();
+            if (!pnode) {
+                return _header;
+            }
+            while (!pnode->leaf) {
+                pnode = _child(pnode, 0);
+            }
+            return pnode;
+        }
+
+        static node_pointer _child(node_pointer pnode, size_type index) {
+            return static_cast<inner_type*>(pnode)->children[index];
+        }
+
+        static void _set_child(node_pointer pnode, size_type index, node_pointer child) {
+            static_cast<inner_type*>(pnode)->children[index] = child;
+            if (child) {
+                child->parent = pnode;
+                child->position = static_cast<unsigned short>(index);
+            }
+        }
+
+        /* First index whose value is not less than key */
+        template<class K>
+        size_type _lower_index(node_pointer pnode, const K& key) const {
+            size_type lo = 0;
+            size_type hi = pnode->count;
+            while (lo < hi) {
+                size_type middle = (lo + hi) / 2;
+                if (_cmp(pnode->value(middle), key)) {
+                    lo = middle + 1;
+                } else {
+                    hi = middle;
+                }
+            }
+            return lo;
+        }
+
+        /* First index whose value is greater than key */
+        template<class K>
+        size_type _upper_index(node_pointer pnode, const K& key) const {
+            size_type lo = 0;
+            size_type hi = pnode->count;
+            while (lo < hi) {
+                size_type middle = (lo + hi) / 2;
+                if (_cmp(key, pnode->value(middle))) {
+                    hi = middle;
+                } else {
+                    lo = middle + 1;
+                }
+            }
+            return lo;
+        }
+
+        /* One descent to the leaf, tracking the greatest value not above
+         * key; that value is checked for equality once at the end */
+        template<class K>
+        _cursor _locate(const K& key, slot_type& slot) const {
+            _cursor candidate = { nullptr, 0 };
+            node_pointer pnode = _root();
+            slot.node = pnode;
+            slot.index = 0;
+            while (pnode) {
+                size_type index = _upper_index(pnode, key);
+                if (index > 0) {
+                    candidate.node = pnode;
+                    candidate.index = index - 1;
+                }
+                slot.node = pnode;
+                slot.index = index;
+                pnode = (pnode->leaf ? nullptr : _child(pnode, index));
+            }
+            if (candidate.node && _cmp(candidate.node->value(candidate.index), key)) {
+                candidate.node = nullptr;
+            }
+            return candidate;
+        }
+
+        template<class K>
+        _cursor _lower_bound(const K& key) const {
+            _cursor bound = { _header, 0 };
+            node_pointer pnode = _root();
+            while (pnode) {
+                size_type index = _lower_index(pnode, key);
+                if (index < pnode->count) {
+                    bound.node = pnode;
+                    bound.index = index;
+                }
+                pnode = (pnode->leaf ? nullptr : _child(pnode, index));
+            }
+            return bound;
+        }
+
+        template<class K>
+        _cursor _upper_bound(const K& key) const {
+            _cursor bound = { _header, 0 };
+            node_pointer pnode = _root();
+            while (pnode) {
+                size_type index = _upper_index(pnode, key);
+                if (index < pnode->count) {
+                    bound.node = pnode;
+                    bound.index = index;
+                }
+                pnode = (pnode->leaf ? nullptr : _child(pnode, index));
+            }
+            return bound;
+        }
+
+        template<class K>
+        _cursor _search(const K& key) const {
+            _cursor bound = _lower_bound(key);
+            if (bound.node != _header && _cmp(key, bound.node->value(bound.index))) {
+                bound.node = _header;
+                bound.index = 0;
+            }
+            return bound;
+        }
+
+        slot_type _slot_before(iterator pos) const {
+            slot_type slot = { pos.base(), pos.index() };
+            if (!slot.node->leaf) {
+                slot.node = _child(slot.node, slot.index);
+                while (!slot.node->leaf) {
+                    slot.node = _child(slot.node, slot.node->count);
+                }
+                slot.index = slot.node->count;
+            }
+            return slot;
+        }
+
+        slot_type _slot_after(iterator pos) const {
+            slot_type slot = { pos.base(), pos.index() + 1 };
+            if (!slot.node->leaf) {
+                slot.node = _child(slot.node, slot.index);
+                while (!slot.node->leaf) {
+                    slot.node = _child(slot.node, 0);
+                }
+                slot.index = 0;
+            }
+            return slot;
+        }
+
+        void _move_value(node_pointer to, size_type to_index, node_pointer from, size_type from_index) {
+            _allocator.construct(&to->value(to_index), from->value(from_index));
+            _allocator.destroy(&from->value(from_index));
+        }
+
+        /* Opens a hole at index: values from index and children after it move up one */
+        void _shift_right(node_pointer pnode, size_type index) {
+            for (size_type i = pnode->count; i > index; --i) {
+                _move_value(pnode, i, pnode, i - 1);
+            }
+            if (!pnode->leaf) {
+                for (size_type i = pnode->count + 1; i > index + 1; --i) {
+                    _set_child(pnode, i, _child(pnode, i - 1));
+                }
+            }
+        }
+
+        /* Closes the hole at index: values after it and children after
+         * index + 1 move down one */
+        void _shift_left(node_pointer pnode, size_type index) {
+            for (size_type i = index + 1; i < pnode->count; ++i) {
+                _move_value(pnode, i - 1, pnode, i);
+            }
+            if (!pnode->leaf) {
+                for (size_type i = index + 2; i <= pnode->count; ++i) {
+                    _set_child(pnode, i - 1, _child(pnode, i));
+                }
+            }
+        }
+
+        /* Splits a full node in two around a separator that goes up to the
+         * parent, splitting the parent first if it is full as well. Inserts
+         * at the end of a node keep it full, so ascending input packs nodes. */
+        void _split(node_pointer pnode, size_type index) {
+            if (pnode->parent == _header) {
+                node_pointer root = _new_node(false);
+                _set_child(_header, 0, root);
+                _set_child(root, 0, pnode);
+            } else if (pnode->parent->count == _slots) {
+                _split(pnode->parent, pnode->position);
+            }
+            node_pointer parent = pnode->parent;
+            size_type position = pnode->position;
+            size_type keep = (index == pnode->count ? pnode->count - 1 : pnode->count / 2);
+            size_type moved = pnode->count - keep - 1;
+            node_pointer right = _new_node(pnode->leaf);
+            for (size_type i = 0; i < moved; ++i) {
+                _move_value(right, i, pnode, keep + 1 + i);
+            }
+            if (!pnode->leaf) {
+                for (size_type i = 0; i <= moved; ++i) {
+                    _set_child(right, i, _child(pnode, keep + 1 + i));
+                }
+            }
+            right->count = static_cast<unsigned short>(moved);
+            _shift_right(parent, position);
+            _move_value(parent, position, pnode, keep);
+            _set_child(parent, position + 1, right);
+            ++parent->count;
+            pnode->count = static_cast<unsigned short>(keep);
+        }
+
+        /* Refills nodes left under half full after an erase, bottom-up */
+        void _rebalance(node_pointer pnode, _cursor& next) {
+            while (pnode->parent != _header && pnode->count < _min_count) {
+                node_pointer parent = pnode->parent;
+                size_type position = pnode->position;
+                node_pointer left = (position > 0 ? _child(parent, position - 1) : nullptr);
+                node_pointer right = (position < parent->count ? _child(parent, position + 1) : nullptr);
+                if (left && left->count > _min_count) {
+                    _borrow_left(pnode, next);
+                    return;
+                }
+                if (right && right->count > _min_count) {
+                    _borrow_right(pnode, next);
+                    return;
+                }
+                _merge(parent, (left ? position - 1 : position), next);
+                pnode = parent;
+            }
+            if (pnode->parent == _header && pnode->count == 0) {
+                if (pnode->leaf) {
+                    _set_child(_header, 0, nullptr);
+                    next.node = _header;
+                    next.index = 0;
+                } else {
+                    _set_child(_header, 0, _child(pnode, 0));
+                }
+                _delete_node(pnode);
+            }
+        }
+
+        /* Rotates the last value of the left sibling through the parent */
+        void _borrow_left(node_pointer pnode, _cursor& next) {
+            node_pointer parent = pnode->parent;
+            size_type position = pnode->position;
+            node_pointer left = _child(parent, position - 1);
+            size_type count = left->count;
+            for (size_type i = pnode->count; i > 0; --i) {
+                _move_value(pnode, i, pnode, i - 1);
+            }
+            if (!pnode->leaf) {
+                for (size_type i = pnode->count + 1; i > 0; --i) {
+                    _set_child(pnode, i, _child(pnode, i - 1));
+                }
+                _set_child(pnode, 0, _child(left, count));
+            }
+            _move_value(pnode, 0, parent, position - 1);
+            _move_value(parent, position - 1, left, count - 1);
+            --left->count;
+            ++pnode->count;
+            if (next.node == pnode) {
+                ++next.index;
+            } else if ((next.node == parent && next.index == position - 1) || (next.node == left && next.index == count)) {
+                next.node = pnode;
+                next.index = 0;
+            } else if (next.node == left && next.index == count - 1) {
+                next.node = parent;
+                next.index = position - 1;
+            }
+        }
+
+        /* Rotates the first value of the right sibling through the parent */
+        void _borrow_right(node_pointer pnode, _cursor& next) {
+            node_pointer parent = pnode->parent;
+            size_type position = pnode->position;
+            node_pointer right = _child(parent, position + 1);
+            size_type count = pnode->count;
+            _move_value(pnode, count, parent, position);
+            _move_value(parent, position, right, 0);
+            if (!pnode->leaf) {
+                _set_child(pnode, count + 1, _child(right, 0));
+            }
+            for (size_type i = 1; i < right->count; ++i) {
+                _move_value(right, i - 1, right, i);
+            }
+            if (!right->leaf) {
+                for (size_type i = 1; i <= right->count; ++i) {
+                    _set_child(right, i - 1, _child(right, i));
+                }
+            }
+            --right->count;
+            ++pnode->count;
+            if (next.node == parent && next.index == position) {
+                next.node = pnode;
+                next.index = count;
+            } else if (next.node == right) {
+                if (next.index == 0) {
+                    next.node = parent;
+                    next.index = position;
+                } else {
+                    --next.index;
+                }
+            }
+        }
+
+        /* Moves the separator at index and the child after it into the child before it */
+        void _merge(node_pointer parent, size_type index, _cursor& next) {
+            node_pointer left = _child(parent, index);
+            node_pointer right = _child(parent, index + 1);
+            size_type count = left->count;
+            _move_value(left, count, parent, index);
+            for (size_type i = 0; i < right->count; ++i) {
+                _move_value(left, count + 1 + i, right, i);
+            }
+            if (!left->leaf) {
+                for (size_type i = 0; i <= right->count; ++i) {
+                    _set_child(left, count + 1 + i, _child(right, i));
+                }
+            }
+            left->count = static_cast<unsigned short>(count + 1 + right->count);
+            _shift_left(parent, index);
+            --parent->count;
+            if (next.node == parent) {
+                if (next.index == index) {
+                    next.node = left;
+                    next.index = count;
+                } else if (next.index > index) {
+                    --next.index;
+                }
+            } else if (next.node == right) {
+                next.node = left;
+                next.index += count + 1;
+            }
+            _delete_node(right);
+        }
+
+        /* A cursor past the last value of a leaf stands for the value after it */
+        iterator _normalize(_cursor position) const {
+            while (position.index == position.node->count && position.node->parent) {
+                position.index = position.node->position;
+                position.node = position.node->parent;
+            }
+            return iterator(position.node, position.index);
+        }
+
+        void _clone(const BTree& other) {
+            if (other._size > 0) {
+                _set_child(_header, 0, _clone_subtree(other._root()));
+                _size = other._size;
+            }
+        }
+
+        node_pointer _clone_subtree(node_pointer from) {
+            node_pointer pnode = _new_node(from->leaf);
+            for (size_type i = 0; i < from->count; ++i) {
+                _allocator.construct(&pnode->value(i), from->value(i));
+            }
+            pnode->count = from->count;
+            if (!from->leaf) {
+                for (size_type i = 0; i <= from->count; ++i) {
+                    _set_child(pnode, i, _clone_subtree(_child(from, i)));
+                }
+            }
+            return pnode;
+        }
+
+        void _delete_subtree(node_pointer pnode) {
+            if (!pnode->leaf) {
+                for (size_type i = 0; i <= pnode->count; ++i) {
+                    _delete_subtree(_child(pnode, i));
+                }
+            }
+            if (!ft::is_trivially_destructible<value_type>::value) {
+                for (size_type i = 0; i < pnode->count; ++i) {
+                    _allocator.destroy(&pnode->value(i));
+                }
+            }
+            _delete_node(pnode);
+        }
+
+        node_pointer _new_node(bool leaf) {
+            node_pointer pnode;
+            if (leaf) {
+                pnode = _leaf_allocator.allocate(1);
+            } else {
+                pnode = _inner_allocator.allocate(1);
+            }
+            pnode->parent = nullptr;
+            pnode->position = 0;
+            pnode->count = 0;
+            pnode->leaf = leaf;
+            return pnode;
+        }
+
+        void _delete_node(node_pointer pnode) {
+            if (pnode->leaf) {
+                _leaf_allocator.deallocate(pnode, 1);
+            } else {
+                _inner_allocator.deallocate(static_cast<inner_type*>(pnode), 1);
+            }
+        }
+
+    private:
+        allocator_type _allocator;
+        leaf_allocator _leaf_allocator;
+        inner_allocator _inner_allocator;
+        compare_type _cmp;
+        node_pointer _header;
+        size_type _size;
+    };
+
+    /* Tree policy for ft::map: a B-tree with nodes of about NodeBytes bytes.
+     * Unlike the binary trees, insert and erase invalidate iterators. */
+    template<size_t NodeBytes = 256>
+    struct btree_tree {
+        template<class Value, class Compare, class Alloc>
+        struct rebind {
+            typedef BTree<Value, Compare, Alloc, NodeBytes> other;
+        };
+    };
+
+} //namespace ft
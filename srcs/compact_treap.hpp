@@ -0,0 +1,838 @@
+#pragma once
+
+#include <limits>
+#include <memory>
+#include <stdexcept>
+
+#include "iterators.hpp"
+#include "iterators_traits.hpp"
+#include "algorithm.hpp"
+#include "pair.hpp"
+#include "vector.hpp"
+
+namespace ft {
+
+    /* Compact treap node: links are 32-bit indices into the node array and
+     * the height fits in a byte. Index 0 is never handed out and stands for
+     * "no node"; a height of 0 marks a free cell. */
+    template<class U>
+    struct _compact_node {
+        typedef U value_type;
+        typedef unsigned int index_type;
+
+        value_type value;
+        index_type left;
+        index_type right;
+        index_type parent;
+        unsigned char height;
+
+        explicit _compact_node(const value_type& value) : value(value), left(0), right(0), parent(0), height(1) {
+        }
+
+        _compact_node(const _compact_node& other)
+                : value(other.value), left(other.left), right(other.right), parent(other.parent), height(other.height) {
+        }
+    };
+
+    /* Node array: cells live in fixed-size chunks, so an index maps to a
+     * cell with a shift and a mask, and cells never move once handed out.
+     * Freed cells are linked through left and reused first. Iterators point
+     * at the array, which the tree keeps on the heap so that swap() leaves
+     * them valid. */
+    template<class Node, class Alloc = std::allocator<Node> >
+    class CompactNodeArray {
+    public:
+        typedef Node node_type;
+        typedef Alloc allocator_type;
+        typedef typename node_type::value_type value_type;
+        typedef typename node_type::index_type index_type;
+        typedef typename allocator_type::pointer pointer;
+        typedef typename allocator_type::size_type size_type;
+
+    private:
+        enum {
+            _chunk_shift = 10,
+            _chunk_cells = 1 << _chunk_shift,
+            _chunk_mask = _chunk_cells - 1
+        };
+
+    public:
+        explicit CompactNodeArray(const allocator_type& allocator = allocator_type())
+                : root(0), _allocator(allocator), _used(0), _free(0) {
+        }
+
+        ~CompactNodeArray() {
+            clear();
+        }
+
+    private:
+        CompactNodeArray(const CompactNodeArray&);
+        CompactNodeArray& operator=(const CompactNodeArray&);
+
+    public:
+        node_type& node(index_type index) const {
+            return _chunks[index >> _chunk_shift][index & _chunk_mask];
+        }
+
+        /* Constructs a node holding value in a free cell */
+        index_type create(const value_type& value) {
+            index_type index = _allocate();
+            _allocator.construct(&node(index), value);
+            return index;
+        }
+
+        void destroy(index_type index) {
+            node_type& cell = node(index);
+            _allocator.destroy(&cell);
+            cell.height = 0;
+            cell.left = _free;
+            _free = index;
+        }
+
+        /* Destroys every live node and returns the chunks to the allocator */
+        void clear() {
+            if (!ft::is_trivially_destructible<value_type>::value) {
+                for (size_type i = 1; i < _used; ++i) {
+                    if (node(i).height) {
+                        _allocator.destroy(&node(i));
+                    }
+                }
+            }
+            for (size_type i = 0; i < _chunks.size(); ++i) {
+                _allocator.deallocate(_chunks[i], _chunk_cells);
+            }
+            _chunks.clear();
+            _used = 0;
+            _free = 0;
+            root = 0;
+        }
+
+        /* Copies other cell by cell into an empty array: indices, links and
+         * the free list come out the same, so no pointer fixing is needed */
+        void clone(const CompactNodeArray& other) {
+            for (size_type i = 0; i < other._chunks.size(); ++i) {
+                _chunks.push_back(_allocator.allocate(_chunk_cells));
+            }
+            for (size_type i = 1; i < other._used; ++i) {
+                const node_type& from = other.node(i);
+                if (from.height) {
+                    _allocator.construct(&node(i), from);
+                } else {
+                    node(i).left = from.left;
+                    node(i).height = 0;
+                }
+            }
+            _used = other._used;
+            _free = other._free;
+            root = other.root;
+        }
+
+        index_type subtree_min(index_type index) const {
+            while (node(index).left) {
+                index = node(index).left;
+            }
+            return index;
+        }
+
+        index_type subtree_max(index_type index) const {
+            while (node(index).right) {
+                index = node(index).right;
+            }
+            return index;
+        }
+
+        /* Bytes taken by the chunks, live or not */
+        size_type memory() const {
+            return _chunks.size() * _chunk_cells * sizeof(node_type);
+        }
+
+    private:
+        index_type _allocate() {
+            if (_free) {
+                index_type index = _free;
+                _free = node(index).left;
+                return index;
+            }
+            if (_used == static_cast<size_type>(std::numeric_limits<index_type>::max())) {
+                throw std::length_error("ft::compact_tree: node index overflow");
+            }
+            if ((_used >> _chunk_shift) == _chunks.size()) {
+                _chunks.push_back(_allocator.allocate(_chunk_cells));
+            }
+            if (_used == 0) {
+                _used = 1;
+            }
+            return static_cast<index_type>(_used++);
+        }
+
+    public:
+        index_type root;
+
+    private:
+        allocator_type _allocator;
+        ft::vector<pointer> _chunks;
+        size_type _used;
+        index_type _free;
+    };
+
+    /* Compact treap iterator: the node array and an index, 0 being end() */
+    template<class Array, typename T>
+    class CompactTreapIter : iterator<T, ft::bidirectional_iterator_tag> {
+    public:
+        typedef ft::bidirectional_iterator_tag iterator_category;
+        typedef typename ft::iterator_traits<T*>::value_type 		value_type;
+        typedef typename ft::iterator_traits<T*>::pointer			pointer;
+        typedef typename ft::iterator_traits<T*>::reference 		reference;
+        typedef typename ft::iterator_traits<T*>::difference_type	difference_type;
+        typedef typename Array::index_type index_type;
+
+    public:
+        CompactTreapIter() : _array(nullptr), _index(0) {
+        }
+
+        CompactTreapIter(const Array* array, index_type index) : _array(array), _index(index) {
+        }
+
+        CompactTreapIter(const CompactTreapIter& other) : _array(other._array), _index(other._index) {
+        }
+
+        CompactTreapIter& operator=(const CompactTreapIter& other) {
+            if (this != &other) {
+                _array = other._array;
+                _index = other._index;
+            }
+            return *this;
+        }
+
+    public:
+        index_type base() const {
+            return _index;
+        }
+
+        reference operator*() const {
+            return _array->node(_index).value;
+        }
+
+        pointer operator->() const {
+            return &(_array->node(_index).value);
+        }
+
+        CompactTreapIter& operator++() {
+            index_type right = _array->node(_index).right;
+            if (right) {
+                _index = _array->subtree_min(right);
+            } else {
+                index_type parent = _array->node(_index).parent;
+                while (parent && _array->node(parent).right == _index) {
+                    _index = parent;
+                    parent = _array->node(_index).parent;
+                }
+                _index = parent;
+            }
+            return *this;
+        }
+
+        CompactTreapIter operator++(int) {
+            CompactTreapIter temp(*this);
+            ++(*this);
+            return temp;
+        }
+
+        CompactTreapIter& operator--() {
+            if (_index == 0) {
+                _index = _array->subtree_max(_array->root);
+                return *this;
+            }
+            index_type left = _array->node(_index).left;
+            if (left) {
+                _index = _array->subtree_max(left);
+            } else {
+                index_type parent = _array->node(_index).parent;
+                while (parent && _array->node(parent).left == _index) {
+                    _index = parent;
+                    parent = _array->node(_index).parent;
+                }
+                _index = parent;
+            }
+            return *this;
+        }
+
+        CompactTreapIter operator--(int) {
+            CompactTreapIter temp(*this);
+            --(*this);
+            return temp;
+        }
+
+    private:
+        const Array* _array;
+        index_type _index;
+    };
+
+    template<class A, class U>
+    bool operator==(const CompactTreapIter<A, U>& lhs, const CompactTreapIter<A, U>& rhs) {
+        return (lhs.base() == rhs.base());
+    }
+
+    template<class A, class U>
+    bool operator!=(const CompactTreapIter<A, U>& lhs, const CompactTreapIter<A, U>& rhs) {
+        return (lhs.base() != rhs.base());
+    }
+
+    /* Compact treap: the same AVL tree as Treap, laid out in a node array.
+     * For small values a node is about half the size of a pointer-linked
+     * one, and neighbours allocated together stay close in memory. */
+    template<class Value, class Compare = std::less<Value>, class Alloc = std::allocator<Value> >
+    class CompactTreap {
+    public:
+        typedef Value value_type;
+        typedef Alloc allocator_type;
+        typedef Compare compare_type;
+        typedef _compact_node<Value> node_type;
+        typedef typename node_type::index_type index_type;
+
+        typedef typename allocator_type::template rebind<node_type>::other node_allocator;
+        typedef CompactNodeArray<node_type, node_allocator> array_type;
+        typedef typename allocator_type::template rebind<array_type>::other array_allocator;
+
+        typedef typename node_allocator::difference_type difference_type;
+        typedef typename node_allocator::size_type size_type;
+        typedef CompactTreapIter<array_type, value_type> iterator;
+        typedef CompactTreapIter<array_type, const value_type> const_iterator;
+        typedef ft::reverse_iterator<iterator> reverse_iterator;
+        typedef ft::reverse_iterator<const_iterator> const_reverse_iterator;
+
+        /* Nodes are array elements addressed by index, they cannot be handed out */
+        struct node_handle {
+        };
+
+        /* No augmentations, no aggregates */
+        typedef void aggregate_type;
+
+        void refresh(iterator) {
+        }
+
+        /* Place for a new node: child of parent on the given side, or the root if parent is 0 */
+        struct slot_type {
+            index_type parent;
+            bool left;
+        };
+
+    public:
+        CompactTreap(const compare_type& cmp, const allocator_type& allocator = allocator_type())
+                : _allocator(allocator), _array_allocator(allocator), _cmp(cmp), _leftmost(0), _rightmost(0), _size(0) {
+            _nodes = _new_array();
+        }
+
+        CompactTreap(const CompactTreap& other)
+                : _allocator(other._allocator), _array_allocator(other._array_allocator), _cmp(other._cmp),
+                  _leftmost(other._leftmost), _rightmost(other._rightmost), _size(other._size) {
+            _nodes = _new_array();
+            _nodes->clone(*other._nodes);
+        }
+
+        CompactTreap& operator=(const CompactTreap& other) {
+            if (this != &other) {
+                _cmp = other._cmp;
+                clear();
+                _nodes->clone(*other._nodes);
+                _leftmost = other._leftmost;
+                _rightmost = other._rightmost;
+                _size = other._size;
+            }
+            return *this;
+        }
+
+        ~CompactTreap() {
+            _array_allocator.destroy(_nodes);
+            _array_allocator.deallocate(_nodes, 1);
+        }
+
+    /* iterators */
+    public:
+        iterator begin() {
+            return iterator(_nodes, _leftmost);
+        }
+
+        const_iterator begin() const {
+            return const_iterator(_nodes, _leftmost);
+        }
+
+        iterator end() {
+            return iterator(_nodes, 0);
+        }
+
+        const_iterator end() const {
+            return const_iterator(_nodes, 0);
+        }
+
+        reverse_iterator rbegin() {
+            return reverse_iterator(end());
+        }
+
+        const_reverse_iterator rbegin() const {
+            return const_reverse_iterator(end());
+        }
+
+        reverse_iterator rend() {
+            return reverse_iterator(begin());
+        }
+
+        const_reverse_iterator rend() const {
+            return const_reverse_iterator(begin());
+        }
+
+    /* Capacity */
+    public:
+        size_type size() const {
+            return _size;
+        }
+
+        /* Bytes held for nodes, free cells included */
+        size_type memory() const {
+            return _nodes->memory();
+        }
+
+    /* Modifiers */
+    public:
+        void clear() {
+            _nodes->clear();
+            _leftmost = _rightmost = 0;
+            _size = 0;
+        }
+
+        ft::pair<iterator, bool> insert(const value_type& value) {
+            slot_type slot;
+            index_type pnode = _locate(value, slot);
+            if (pnode) {
+                return ft::make_pair(iterator(_nodes, pnode), false);
+            } else {
+                return ft::make_pair(insert_at(slot, value), true);
+            }
+        }
+
+        /* Same contract as Treap::locate() */
+        template<class K>
+        iterator locate(const K& key, slot_type& slot) {
+            return iterator(_nodes, _locate(key, slot));
+        }
+
+        iterator insert_at(const slot_type& slot, const value_type& value) {
+            index_type pnode = _nodes->create(value);
+            _node(pnode).parent = slot.parent;
+            if (slot.parent == 0) {
+                _nodes->root = _leftmost = _rightmost = pnode;
+            } else {
+                if (slot.left) {
+                    _node(slot.parent).left = pnode;
+                    if (slot.parent == _leftmost) {
+                        _leftmost = pnode;
+                    }
+                } else {
+                    _node(slot.parent).right = pnode;
+                    if (slot.parent == _rightmost) {
+                        _rightmost = pnode;
+                    }
+                }
+                _rebalance_up(slot.parent);
+            }
+            ++_size;
+            return iterator(_nodes, pnode);
+        }
+
+        /* Same contract as Treap::assign(). Nodes are created in input
+         * order, so sorted input also comes out sorted in memory. */
+        template<class InputIt>
+        void assign(InputIt first, InputIt last) {
+            ft::vector<index_type> nodes;
+            bool sorted = true;
+            clear();
+            for (; first != last; ++first) {
+                nodes.push_back(_nodes->create(*first));
+                if (sorted && nodes.size() > 1) {
+                    sorted = _cmp(_node(nodes[nodes.size() - 2]).value, _node(nodes.back()).value);
+                }
+            }
+            size_type count = nodes.size();
+            if (!sorted) {
+                ft::stable_sort(nodes.begin(), nodes.end(), _node_compare(_cmp, _nodes));
+                count = 1;
+                for (size_type i = 1; i < nodes.size(); ++i) {
+                    if (_cmp(_node(nodes[count - 1]).value, _node(nodes[i]).value)) {
+                        nodes[count++] = nodes[i];
+                    } else {
+                        _nodes->destroy(nodes[i]);
+                    }
+                }
+            }
+            if (count > 0) {
+                _nodes->root = _build_balanced(nodes.data(), count, 0);
+                _leftmost = nodes[0];
+                _rightmost = nodes[count - 1];
+                _size = count;
+            }
+        }
+
+        iterator insert(iterator hint, const value_type& value) {
+            index_type pos = hint.base();
+            slot_type slot;
+            if (_size == 0) {
+                return insert(value).first;
+            }
+            if (pos == 0) {
+                if (_cmp(_node(_rightmost).value, value)) {
+                    slot.parent = _rightmost;
+                    slot.left = false;
+                    return insert_at(slot, value);
+                }
+            } else if (_cmp(value, _node(pos).value)) {
+                if (pos == _leftmost) {
+                    slot.parent = pos;
+                    slot.left = true;
+                    return insert_at(slot, value);
+                }
+                index_type prev = (--hint).base();
+                if (_cmp(_node(prev).value, value)) {
+                    slot.parent = (_node(pos).left ? prev : pos);
+                    slot.left = !_node(pos).left;
+                    return insert_at(slot, value);
+                }
+            } else if (_cmp(_node(pos).value, value)) {
+                if (pos == _rightmost) {
+                    slot.parent = pos;
+                    slot.left = false;
+                    return insert_at(slot, value);
+                }
+                index_type next = (++hint).base();
+                if (_cmp(value, _node(next).value)) {
+                    slot.parent = (_node(pos).right ? next : pos);
+                    slot.left = (_node(pos).right != 0);
+                    return insert_at(slot, value);
+                }
+            } else {
+                return iterator(_nodes, pos);
+            }
+            return insert(value).first;
+        }
+
+        iterator erase(iterator pos) {
+            if (pos == end()) {
+                return pos;
+            }
+            iterator next = pos;
+            ++next;
+            _erase_node(pos.base());
+            return next;
+        }
+
+        iterator erase(iterator first, iterator last) {
+            if (first == begin() && last == end()) {
+                clear();
+                return end();
+            }
+            while (first != last) {
+                first = erase(first);
+            }
+            return last;
+        }
+
+        void swap(CompactTreap& other) {
+            ft::swap(_allocator, other._allocator);
+            ft::swap(_array_allocator, other._array_allocator);
+            ft::swap(_nodes, other._nodes);
+            ft::swap(_cmp, other._cmp);
+            ft::swap(_leftmost, other._leftmost);
+            ft::swap(_rightmost, other._rightmost);
+            ft::swap(_size, other._size);
+        }
+
+    /* Lookup */
+    public:
+        template<class K>
+        iterator find(const K& key) {
+            return iterator(_nodes, _search(key));
+        }
+
+        template<class K>
+        const_iterator find(const K& key) const {
+            return const_iterator(_nodes, _search(key));
+        }
+
+        template<class K>
+        iterator lower_bound(const K& key) {
+            return iterator(_nodes, _lower_bound(key));
+        }
+
+        template<class K>
+        const_iterator lower_bound(const K& key) const {
+            return const_iterator(_nodes, _lower_bound(key));
+        }
+
+        template<class K>
+        iterator upper_bound(const K& key) {
+            return iterator(_nodes, _upper_bound(key));
+        }
+
+        template<class K>
+        const_iterator upper_bound(const K& key) const {
+            return const_iterator(_nodes, _upper_bound(key));
+        }
+
+    /* Observers */
+    public:
+        compare_type value_comp() {
+            return _cmp;
+        }
+
+    /* private helpers */
+    private:
+        node_type& _node(index_type index) const {
+            return _nodes->node(index);
+        }
+
+        template<class K>
+        index_type _locate(const K& key, slot_type& slot) const {
+            index_type pnode = _nodes->root;
+            index_type candidate = 0;
+            slot.parent = 0;
+            slot.left = true;
+            while (pnode) {
+                const node_type& node = _node(pnode);
+                slot.parent = pnode;
+                if (_cmp(key, node.value)) {
+                    slot.left = true;
+                    pnode = node.left;
+                } else {
+                    candidate = pnode;
+                    slot.left = false;
+                    pnode = node.right;
+                }
+            }
+            if (candidate && !_cmp(_node(candidate).value, key)) {
+                return candidate;
+            }
+            return 0;
+        }
+
+        int _height(index_type pnode) const {
+            return (pnode ? _node(pnode).height : 0);
+        }
+
+        int _bfactor(index_type pnode) const {
+            return _height(_node(pnode).right) - _height(_node(pnode).left);
+        }
+
+        void _fix_height(index_type pnode) {
+            int hl = _height(_node(pnode).left);
+            int hr = _height(_node(pnode).right);
+            _node(pnode).height = static_cast<unsigned char>((hl > hr ? hl : hr) + 1);
+        }
+
+        index_type _rotate_right(index_type p) {
+            node_type& np = _node(p);
+            index_type q = np.left;
+            node_type& nq = _node(q);
+            nq.parent = np.parent;
+            np.left = nq.right;
+            if (nq.right) {
+                _node(nq.right).parent = p;
+            }
+            nq.right = p;
+            np.parent = q;
+            _fix_height(p);
+            _fix_height(q);
+            return q;
+        }
+
+        index_type _rotate_left(index_type q) {
+            node_type& nq = _node(q);
+            index_type p = nq.right;
+            node_type& np = _node(p);
+            np.parent = nq.parent;
+            nq.right = np.left;
+            if (np.left) {
+                _node(np.left).parent = q;
+            }
+            np.left = q;
+            nq.parent = p;
+            _fix_height(q);
+            _fix_height(p);
+            return p;
+        }
+
+        index_type _balance(index_type pnode) {
+            _fix_height(pnode);
+            if (_bfactor(pnode) == 2) {
+                if (_bfactor(_node(pnode).right) < 0) {
+                    _node(pnode).right = _rotate_right(_node(pnode).right);
+                }
+                return _rotate_left(pnode);
+            }
+            if (_bfactor(pnode) == -2) {
+                if (_bfactor(_node(pnode).left) > 0) {
+                    _node(pnode).left = _rotate_left(_node(pnode).left);
+                }
+                return _rotate_right(pnode);
+            }
+            return pnode;
+        }
+
+        void _erase_node(index_type pnode) {
+            node_type& node = _node(pnode);
+            index_type parent = node.parent;
+            index_type rebalance_from = parent;
+            if (pnode == _leftmost) {
+                _leftmost = (_size > 1 ? (++iterator(_nodes, pnode)).base() : 0);
+            }
+            if (pnode == _rightmost) {
+                _rightmost = (_size > 1 ? (--iterator(_nodes, pnode)).base() : 0);
+            }
+            if (!node.left || !node.right) {
+                index_type child = (node.left ? node.left : node.right);
+                if (child) {
+                    _node(child).parent = parent;
+                }
+                _replace_child(parent, pnode, child);
+            } else {
+                index_type successor = _nodes->subtree_min(node.right);
+                node_type& next = _node(successor);
+                if (next.parent != pnode) {
+                    rebalance_from = next.parent;
+                    _node(next.parent).left = next.right;
+                    if (next.right) {
+                        _node(next.right).parent = next.parent;
+                    }
+                    next.right = node.right;
+                    _node(node.right).parent = successor;
+                } else {
+                    rebalance_from = successor;
+                }
+                next.left = node.left;
+                _node(node.left).parent = successor;
+                next.parent = parent;
+                next.height = node.height;
+                _replace_child(parent, pnode, successor);
+            }
+            _nodes->destroy(pnode);
+            --_size;
+            _rebalance_up(rebalance_from);
+        }
+
+        void _rebalance_up(index_type pnode) {
+            while (pnode) {
+                index_type parent = _node(pnode).parent;
+                unsigned char height = _node(pnode).height;
+                index_type subtree = _balance(pnode);
+                _replace_child(parent, pnode, subtree);
+                if (_node(subtree).height == height) {
+                    break;
+                }
+                pnode = parent;
+            }
+        }
+
+        void _replace_child(index_type parent, index_type from, index_type to) {
+            if (parent == 0) {
+                _nodes->root = to;
+            } else if (_node(parent).left == from) {
+                _node(parent).left = to;
+            } else {
+                _node(parent).right = to;
+            }
+        }
+
+        index_type _build_balanced(index_type* nodes, size_type count, index_type parent) {
+            if (count == 0) {
+                return 0;
+            }
+            size_type middle = count / 2;
+            index_type pnode = nodes[middle];
+            _node(pnode).parent = parent;
+            _node(pnode).left = _build_balanced(nodes, middle, pnode);
+            _node(pnode).right = _build_balanced(nodes + middle + 1, count - middle - 1, pnode);
+            unsigned char height = 0;
+            for (; count > 0; count /= 2) {
+                ++height;
+            }
+            _node(pnode).height = height;
+            return pnode;
+        }
+
+        template<class K>
+        index_type _lower_bound(const K& key) const {
+            index_type pnode = _nodes->root;
+            index_type bound = 0;
+            while (pnode) {
+                const node_type& node = _node(pnode);
+                if (_cmp(node.value, key)) {
+                    pnode = node.right;
+                } else {
+                    bound = pnode;
+                    pnode = node.left;
+                }
+            }
+            return bound;
+        }
+
+        template<class K>
+        index_type _upper_bound(const K& key) const {
+            index_type pnode = _nodes->root;
+            index_type bound = 0;
+            while (pnode) {
+                const node_type& node = _node(pnode);
+                if (_cmp(key, node.value)) {
+                    bound = pnode;
+                    pnode = node.left;
+                } else {
+                    pnode = node.right;
+                }
+            }
+            return bound;
+        }
+
+        template<class K>
+        index_type _search(const K& key) const {
+            index_type pnode = _lower_bound(key);
+            if (pnode && !_cmp(key, _node(pnode).value)) {
+                return pnode;
+            }
+            return 0;
+        }
+
+        array_type* _new_array() {
+            array_type* nodes = _array_allocator.allocate(1);
+            _array_allocator.construct(nodes, node_allocator(_allocator));
+            return nodes;
+        }
+
+    private:
+        struct _node_compare {
+            compare_type cmp;
+            const array_type* nodes;
+
+            _node_compare(const compare_type& cmp, const array_type* nodes) : cmp(cmp), nodes(nodes) {
+            }
+
+            bool operator()(index_type lhs, index_type rhs) const {
+                return cmp(nodes->node(lhs).value, nodes->node(rhs).value);
+            }
+        };
+
+    private:
+        allocator_type _allocator;
+        array_allocator _array_allocator;
+        array_type* _nodes;
+        compare_type _cmp;
+        index_type _leftmost;
+        index_type _rightmost;
+        size_type _size;
+    };
+
+    /* Tree policy for ft::map: nodes in a compact array with 32-bit links */
+    struct compact_tree {
+        template<class Value, class Compare, class Alloc>
+        struct rebind {
+            typedef CompactTreap<Value, Compare, Alloc> other;
+        };
+    };
+
+} //namespace ft
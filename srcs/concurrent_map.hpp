@@ -0,0 +1,513 @@
+#pragma once
+
+#include <cstddef>
+#include <stdint.h>
+#include <memory>
+
+#include "iterators_traits.hpp"
+#include "pair.hpp"
+#include "epoch.hpp"
+
+namespace ft {
+
+    /* A skiplist node and its tower: next[level] for level < height. The low
+     * bit of a link marks the node as being removed at that level. */
+    template<class U>
+    struct _skip_node {
+        typedef U value_type;
+
+        value_type value;
+        int height;
+        /* The inserter and the remover: the last one to let go retires it */
+        int owners;
+        _skip_node* next[1];
+    };
+
+    /* Forward iterator over the nodes not removed when it passes them. It
+     * holds a guard of its session's epoch while it points to a node, so
+     * the node stays allocated: keep it on the session's thread and not
+     * longer than needed, it holds back reclamation. */
+    template<class Node, class T>
+    class SkipListIter {
+    public:
+        typedef ft::forward_iterator_tag iterator_category;
+        typedef typename ft::iterator_traits<T*>::value_type value_type;
+        typedef T* pointer;
+        typedef T& reference;
+        typedef std::ptrdiff_t difference_type;
+
+    public:
+        SkipListIter() : _self(nullptr), _node(nullptr) {
+        }
+
+        SkipListIter(EpochDomain::participant* self, Node* node) : _self(node ? self : nullptr), _node(node) {
+            _pin();
+        }
+
+        SkipListIter(const SkipListIter& other) : _self(other._self), _node(other._node) {
+            _pin();
+        }
+
+        ~SkipListIter() {
+            _unpin();
+        }
+
+        SkipListIter& operator=(const SkipListIter& other) {
+            if (this != &other) {
+                _unpin();
+                _self = other._self;
+                _node = other._node;
+                _pin();
+            }
+            return *this;
+        }
+
+    public:
+        Node* base() const {
+            return _node;
+        }
+
+        reference operator*() const {
+            return _node->value;
+        }
+
+        pointer operator->() const {
+            return &_node->value;
+        }
+
+        SkipListIter& operator++() {
+            Node* next = _strip(__atomic_load_n(&_node->next[0], __ATOMIC_ACQUIRE));
+            while (next) {
+                Node* link = __atomic_load_n(&next->next[0], __ATOMIC_ACQUIRE);
+                if (!_marked(link)) {
+                    break;
+                }
+                next = _strip(link);
+            }
+            _node = next;
+            if (_node == nullptr) {
+                _unpin();
+                _self = nullptr;
+            }
+            return *this;
+        }
+
+        SkipListIter operator++(int) {
+            SkipListIter tmp(*this);
+            ++(*this);
+            return tmp;
+        }
+
+    private:
+        static bool _marked(Node* link) {
+            return (reinterpret_cast<uintptr_t>(link) & 1);
+        }
+
+        static Node* _strip(Node* link) {
+            return reinterpret_cast<Node*>(reinterpret_cast<uintptr_t>(link) & ~uintptr_t(1));
+        }
+
+        void _pin() {
+            if (_self) {
+                _self->enter();
+            }
+        }
+
+        void _unpin() {
+            if (_self) {
+                _self->exit();
+            }
+        }
+
+    private:
+        EpochDomain::participant* _self;
+        Node* _node;
+    };
+
+    template<class Node, class U, class V>
+    bool operator==(const SkipListIter<Node, U>& lhs, const SkipListIter<Node, V>& rhs) {
+        return lhs.base() == rhs.base();
+    }
+
+    template<class Node, class U, class V>
+    bool operator!=(const SkipListIter<Node, U>& lhs, const SkipListIter<Node, V>& rhs) {
+        return lhs.base() != rhs.base();
+    }
+
+    /* An ordered map any number of threads read and write at once: a
+     * lock-free skiplist whose towers are linked with compare-and-swap.
+     * A removal marks the links of its node top down, the mark on the
+     * bottom link decides which remover wins, and searches unlink marked
+     * nodes as they pass them. Removed nodes are reclaimed through an
+     * EpochDomain.
+     *
+     * Threads reach the map through a session each, which has the ordered
+     * map lookups and modifiers. Elements cannot be changed once inserted.
+     * Iterators are weakly consistent: they see every element present for
+     * their whole walk, and may or may not see the others. size() walks
+     * the map. All sessions must end before the map. */
+    template<class Key, class T, class Compare = std::less<Key>, class Alloc = std::allocator<pair<const Key, T> > >
+    class concurrent_map {
+    public:
+        typedef Key key_type;
+        typedef T mapped_type;
+        typedef pair<const Key, T> value_type;
+        typedef Compare key_compare;
+        typedef Alloc allocator_type;
+        typedef typename allocator_type::size_type size_type;
+        typedef typename allocator_type::difference_type difference_type;
+
+        enum { max_height = 32 };
+
+    private:
+        typedef _skip_node<value_type> node_type;
+        typedef node_type* node_pointer;
+        typedef typename allocator_type::template rebind<char>::other byte_allocator;
+
+    public:
+        typedef SkipListIter<node_type, const value_type> iterator;
+        typedef iterator const_iterator;
+
+        /* A thread's access to the map */
+        class session {
+        public:
+            explicit session(concurrent_map& map) : _map(map), _self(map._domain), _seed(_seed_of(this)) {
+            }
+
+        public:
+            iterator begin() {
+                EpochDomain::guard guard(_self);
+                return iterator(&_self, _map._first(_load(&_map._head->next[0])));
+            }
+
+            iterator end() {
+                return iterator();
+            }
+
+            bool empty() {
+                return (begin() == end());
+            }
+
+            /* O(n): counts the elements while walking them */
+            size_type size() {
+                size_type count = 0;
+                for (iterator it = begin(); it != end(); ++it) {
+                    ++count;
+                }
+                return count;
+            }
+
+            ft::pair<iterator, bool> insert(const value_type& value) {
+                EpochDomain::guard guard(_self);
+                ft::pair<node_pointer, bool> result = _map._insert(_self, value, _random_height());
+                return ft::make_pair(iterator(&_self, result.first), result.second);
+            }
+
+            size_type erase(const key_type& key) {
+                EpochDomain::guard guard(_self);
+                return (_map._erase(_self, key));
+            }
+
+            iterator find(const key_type& key) {
+                EpochDomain::guard guard(_self);
+                node_pointer node = _map._lower_bound(key);
+                if (node && _map._cmp(key, node->value.first)) {
+                    node = nullptr;
+                }
+                return iterator(&_self, node);
+            }
+
+            size_type count(const key_type& key) {
+                return (find(key) != end());
+            }
+
+            iterator lower_bound(const key_type& key) {
+                EpochDomain::guard guard(_self);
+                return iterator(&_self, _map._lower_bound(key));
+            }
+
+            iterator upper_bound(const key_type& key) {
+                EpochDomain::guard guard(_self);
+                return iterator(&_self, _map._upper_bound(key));
+            }
+
+        private:
+            session(const session&);
+            session& operator=(const session&);
+
+            static uint64_t _seed_of(const void* self) {
+                uint64_t seed = reinterpret_cast<uintptr_t>(self) * 0x9E3779B97F4A7C15ULL;
+                return (seed ? seed : 1);
+            }
+
+            /* 1 + the number of trailing zero bit pairs: height h has
+             * probability 4^-h, at most max_height */
+            int _random_height() {
+                _seed ^= _seed << 13;
+                _seed ^= _seed >> 7;
+                _seed ^= _seed << 17;
+                uint64_t bits = _seed;
+                int height = 1;
+                while ((bits & 3) == 0 && height < max_height) {
+                    bits >>= 2;
+                    ++height;
+                }
+                return height;
+            }
+
+        private:
+            concurrent_map& _map;
+            EpochDomain::participant _self;
+            uint64_t _seed;
+        };
+
+    public:
+        explicit concurrent_map(const key_compare& comp = key_compare(), const allocator_type& alloc = allocator_type())
+                : _allocator(alloc), _byte_allocator(alloc), _cmp(comp), _levels(1) {
+            _head = reinterpret_cast<node_pointer>(_byte_allocator.allocate(_node_bytes(max_height)));
+            _head->height = max_height;
+            for (int level = 0; level < max_height; ++level) {
+                _head->next[level] = nullptr;
+            }
+        }
+
+        /* No session may be left */
+        ~concurrent_map() {
+            node_pointer node = _strip(_head->next[0]);
+            while (node) {
+                node_pointer next = _strip(node->next[0]);
+                _destroy(node);
+                node = next;
+            }
+            _byte_allocator.deallocate(reinterpret_cast<char*>(_head), _node_bytes(max_height));
+        }
+
+        key_compare key_comp() const {
+            return _cmp;
+        }
+
+        allocator_type get_allocator() const {
+            return _allocator;
+        }
+
+    private:
+        concurrent_map(const concurrent_map&);
+        concurrent_map& operator=(const concurrent_map&);
+
+    /* links */
+    private:
+        static bool _marked(node_pointer link) {
+            return (reinterpret_cast<uintptr_t>(link) & 1);
+        }
+
+        static node_pointer _strip(node_pointer link) {
+            return reinterpret_cast<node_pointer>(reinterpret_cast<uintptr_t>(link) & ~uintptr_t(1));
+        }
+
+        static node_pointer _mark(node_pointer link) {
+            return reinterpret_cast<node_pointer>(reinterpret_cast<uintptr_t>(link) | 1);
+        }
+
+        static node_pointer _load(node_pointer* link) {
+            return __atomic_load_n(link, __ATOMIC_ACQUIRE);
+        }
+
+        static bool _cas(node_pointer* link, node_pointer expected, node_pointer desired) {
+            return __atomic_compare_exchange_n(link, &expected, desired, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE);
+        }
+
+        /* First node from node on not being removed */
+        static node_pointer _first(node_pointer node) {
+            node = _strip(node);
+            while (node && _marked(_load(&node->next[0]))) {
+                node = _strip(_load(&node->next[0]));
+            }
+            return node;
+        }
+
+    /* lookups: walk past removed nodes, change nothing */
+    private:
+        node_pointer _lower_bound(const key_type& key) const {
+            return _descend(key, false);
+        }
+
+        node_pointer _upper_bound(const key_type& key) const {
+            return _descend(key, true);
+        }
+
+        /* First node not before key, or after it with upper */
+        node_pointer _descend(const key_type& key, bool upper) const {
+            node_pointer pred = _head;
+            node_pointer curr = nullptr;
+            for (int level = __atomic_load_n(&_levels, __ATOMIC_RELAXED) - 1; level >= 0; --level) {
+                curr = _strip(_load(&pred->next[level]));
+                while (curr) {
+                    node_pointer succ = _load(&curr->next[level]);
+                    if (_marked(succ)) {
+                        curr = _strip(succ);
+                    } else if (upper ? !_cmp(key, curr->value.first) : _cmp(curr->value.first, key)) {
+                        pred = curr;
+                        curr = succ;
+                    } else {
+                        break;
+                    }
+                }
+            }
+            return curr;
+        }
+
+    /* modifiers */
+    private:
+        /* Neighbours of key on every level, unlinking the removed nodes met
+         * on the way: preds[level] is before key, succs[level] is the first
+         * node not before it. Returns whether succs[0] holds key. */
+        bool _search(const key_type& key, node_pointer* preds, node_pointer* succs) {
+            while (!_try_search(key, preds, succs)) {
+            }
+            return (succs[0] && !_cmp(key, succs[0]->value.first));
+        }
+
+        /* Fails when a node could not be unlinked: its predecessor changed */
+        bool _try_search(const key_type& key, node_pointer* preds, node_pointer* succs) {
+            node_pointer pred = _head;
+            node_pointer curr = nullptr;
+            for (int level = max_height - 1; level >= 0; --level) {
+                curr = _strip(_load(&pred->next[level]));
+                while (curr) {
+                    node_pointer succ = _load(&curr->next[level]);
+                    if (_marked(succ)) {
+                        if (!_cas(&pred->next[level], curr, _strip(succ))) {
+                            return (false);
+                        }
+                        curr = _strip(succ);
+                    } else if (_cmp(curr->value.first, key)) {
+                        pred = curr;
+                        curr = succ;
+                    } else {
+                        break;
+                    }
+                }
+                preds[level] = pred;
+                succs[level] = curr;
+            }
+            return (true);
+        }
+
+        ft::pair<node_pointer, bool> _insert(EpochDomain::participant& self, const value_type& value, int height) {
+            node_pointer preds[max_height];
+            node_pointer succs[max_height];
+            node_pointer node = nullptr;
+            while (true) {
+                if (_search(value.first, preds, succs)) {
+                    if (node) {
+                        _destroy(node);
+                    }
+                    return ft::make_pair(succs[0], false);
+                }
+                if (!node) {
+                    node = _create(value, height);
+                }
+                for (int level = 0; level < height; ++level) {
+                    node->next[level] = succs[level];
+                }
+                if (_cas(&preds[0]->next[0], succs[0], node)) {
+                    break;
+                }
+            }
+            _raise_levels(height);
+            for (int level = 1; level < height; ++level) {
+                while (true) {
+                    node_pointer link = _load(&node->next[level]);
+                    if (_marked(link) || (link != succs[level] && !_cas(&node->next[level], link, succs[level]))) {
+                        _release(self, node);
+                        return ft::make_pair(node, true);
+                    }
+                    if (_cas(&preds[level]->next[level], succs[level], node)) {
+                        break;
+                    }
+                    if (!_search(value.first, preds, succs) || succs[0] != node) {
+                        _release(self, node);
+                        return ft::make_pair(node, true);
+                    }
+                }
+            }
+            _release(self, node);
+            return ft::make_pair(node, true);
+        }
+
+        size_type _erase(EpochDomain::participant& self, const key_type& key) {
+            node_pointer preds[max_height];
+            node_pointer succs[max_height];
+            if (!_search(key, preds, succs)) {
+                return (0);
+            }
+            node_pointer victim = succs[0];
+            for (int level = victim->height - 1; level > 0; --level) {
+                node_pointer link = _load(&victim->next[level]);
+                while (!_marked(link) && !_cas(&victim->next[level], link, _mark(link))) {
+                    link = _load(&victim->next[level]);
+                }
+            }
+            while (true) {
+                node_pointer link = _load(&victim->next[0]);
+                if (_marked(link)) {
+                    return (0);
+                }
+                if (_cas(&victim->next[0], link, _mark(link))) {
+                    break;
+                }
+            }
+            _release(self, victim);
+            return (1);
+        }
+
+        /* The inserter is done linking, or the remover unlinking: the last
+         * one unlinks it for good and retires it */
+        void _release(EpochDomain::participant& self, node_pointer node) {
+            if (__atomic_sub_fetch(&node->owners, 1, __ATOMIC_ACQ_REL) == 0) {
+                node_pointer preds[max_height];
+                node_pointer succs[max_height];
+                _search(node->value.first, preds, succs);
+                self.retire(node, &_retire_node, this);
+            }
+        }
+
+        void _raise_levels(int height) {
+            int levels = __atomic_load_n(&_levels, __ATOMIC_RELAXED);
+            while (levels < height && !__atomic_compare_exchange_n(&_levels, &levels, height, false, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+            }
+        }
+
+    /* nodes */
+    private:
+        static size_t _node_bytes(int height) {
+            return sizeof(node_type) + (height - 1) * sizeof(node_pointer);
+        }
+
+        node_pointer _create(const value_type& value, int height) {
+            node_pointer node = reinterpret_cast<node_pointer>(_byte_allocator.allocate(_node_bytes(height)));
+            _allocator.construct(&node->value, value);
+            node->height = height;
+            node->owners = 2;
+            return node;
+        }
+
+        void _destroy(node_pointer node) {
+            _allocator.destroy(&node->value);
+            _byte_allocator.deallocate(reinterpret_cast<char*>(node), _node_bytes(node->height));
+        }
+
+        static void _retire_node(void* node, void* context) {
+            static_cast<concurrent_map*>(context)->_destroy(static_cast<node_pointer>(node));
+        }
+
+    private:
+        allocator_type _allocator;
+        byte_allocator _byte_allocator;
+        key_compare _cmp;
+        node_pointer _head;
+        int _levels;
+        EpochDomain _domain;
+    };
+
+} //namespace ft
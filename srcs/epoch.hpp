@@ -0,0 +1,191 @@
+#pragma once
+
+#include <cstddef>
+#include <sched.h>
+
+#include "vector.hpp"
+
+namespace ft {
+
+    /* Epoch-based reclamation. Threads taking part register a slot; a
+     * thread reading shared nodes holds a guard, which publishes the global
+     * epoch it started in. An object unlinked from a shared structure is
+     * retired with the epoch of the moment, and destroyed once every
+     * guard still held started in a later epoch: no reader can reach it
+     * any more. Readers never wait and never write shared cache lines but
+     * their own slot.
+     *
+     * Each participant keeps its own retired objects, so any number of
+     * threads may retire at once. A participant is used by one thread at
+     * a time. */
+    class EpochDomain {
+    public:
+        enum { max_participants = 256 };
+
+        class participant;
+
+        /* A read-side critical section: nodes reached while it lives stay
+         * allocated. Guards nest, the outermost one publishes the epoch. */
+        class guard {
+        public:
+            explicit guard(participant& self) : _self(self) {
+                _self.enter();
+            }
+
+            ~guard() {
+                _self.exit();
+            }
+
+        private:
+            guard(const guard&);
+            guard& operator=(const guard&);
+
+        private:
+            participant& _self;
+        };
+
+        /* A thread's slot and the objects it retired */
+        class participant {
+        public:
+            explicit participant(EpochDomain& domain) : _domain(domain), _slot(domain._acquire_slot()), _depth(0), _retired_since(0) {
+            }
+
+            /* Waits until everything it retired could be destroyed */
+            ~participant() {
+                while (!_retired.empty()) {
+                    collect();
+                    if (!_retired.empty()) {
+                        sched_yield();
+                    }
+                }
+                _domain._release_slot(_slot);
+            }
+
+            void enter() {
+                if (_depth++ == 0) {
+                    size_t epoch = __atomic_load_n(&_domain._epoch, __ATOMIC_ACQUIRE);
+                    __atomic_store_n(&_domain._slots[_slot].epoch, epoch, __ATOMIC_SEQ_CST);
+                    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+                }
+            }
+
+            void exit() {
+                if (--_depth == 0) {
+                    __atomic_store_n(&_domain._slots[_slot].epoch, 0, __ATOMIC_RELEASE);
+                }
+            }
+
+            /* Hands object, already unreachable to new readers, over to
+             * destroy(object, context) once old readers are done with it */
+            void retire(void* object, void (*destroy)(void*, void*), void* context) {
+                _retired_object retired;
+                retired.object = object;
+                retired.destroy = destroy;
+                retired.context = context;
+                retired.epoch = __atomic_fetch_add(&_domain._epoch, 1, __ATOMIC_SEQ_CST);
+                _retired.push_back(retired);
+                if (++_retired_since >= _collect_every) {
+                    collect();
+                }
+            }
+
+            /* Destroys the retired objects no guard can still reach */
+            void collect() {
+                _retired_since = 0;
+                size_t oldest = _domain._oldest_guard();
+                size_t kept = 0;
+                for (size_t i = 0; i < _retired.size(); ++i) {
+                    if (_retired[i].epoch < oldest) {
+                        _retired[i].destroy(_retired[i].object, _retired[i].context);
+                    } else {
+                        _retired[kept++] = _retired[i];
+                    }
+                }
+                _retired.erase(_retired.begin() + kept, _retired.end());
+            }
+
+            size_t pending() const {
+                return _retired.size();
+            }
+
+        private:
+            participant(const participant&);
+            participant& operator=(const participant&);
+
+        private:
+            struct _retired_object {
+                void* object;
+                void (*destroy)(void*, void*);
+                void* context;
+                size_t epoch;
+            };
+
+            enum { _collect_every = 64 };
+
+            EpochDomain& _domain;
+            size_t _slot;
+            size_t _depth;
+            ft::vector<_retired_object> _retired;
+            size_t _retired_since;
+        };
+
+    public:
+        EpochDomain() : _epoch(1) {
+            for (size_t i = 0; i < max_participants; ++i) {
+                _slots[i].epoch = 0;
+                _slots[i].used = 0;
+            }
+        }
+
+        ~EpochDomain() {
+        }
+
+    private:
+        EpochDomain(const EpochDomain&);
+        EpochDomain& operator=(const EpochDomain&);
+
+        size_t _acquire_slot() {
+            while (true) {
+                for (size_t i = 0; i < max_participants; ++i) {
+                    int expected = 0;
+                    if (__atomic_compare_exchange_n(&_slots[i].used, &expected, 1, false, __ATOMIC_ACQ_REL, __ATOMIC_RELAXED)) {
+                        return i;
+                    }
+                }
+                sched_yield();
+            }
+        }
+
+        void _release_slot(size_t slot) {
+            __atomic_store_n(&_slots[slot].epoch, 0, __ATOMIC_RELAXED);
+            __atomic_store_n(&_slots[slot].used, 0, __ATOMIC_RELEASE);
+        }
+
+        /* Epoch of the oldest guard held, past the current one with none */
+        size_t _oldest_guard() const {
+            __atomic_thread_fence(__ATOMIC_SEQ_CST);
+            size_t oldest = __atomic_load_n(&_epoch, __ATOMIC_ACQUIRE) + 1;
+            for (size_t i = 0; i < max_participants; ++i) {
+                size_t epoch = __atomic_load_n(&_slots[i].epoch, __ATOMIC_ACQUIRE);
+                if (epoch != 0 && epoch < oldest) {
+                    oldest = epoch;
+                }
+            }
+            return oldest;
+        }
+
+    private:
+        /* One cache line per slot, so readers do not share lines */
+        struct _slot_type {
+            size_t epoch;
+            int used;
+            char pad[64 - sizeof(size_t) - sizeof(int)];
+        };
+
+        char _pad_before[64];
+        size_t _epoch;
+        char _pad_after[64 - sizeof(size_t)];
+        _slot_type _slots[max_participants];
+    };
+
+} //namespace ft
@@ -0,0 +1,726 @@
+#pragma once
+
+#include <memory>
+#include <stdexcept>
+
+#include "iterators.hpp"
+#include "iterators_traits.hpp"
+#include "algorithm.hpp"
+#include "pair.hpp"
+#include "vector.hpp"
+
+namespace ft {
+
+    /* flat_map iterator: walks the key and the mapped arrays in step. There
+     * is no pair in memory to point at, so * yields a pair of references
+     * and -> goes through a proxy holding one. */
+    template<class Key, class T, class Mapped>
+    class FlatMapIter {
+    public:
+        typedef ft::random_access_iterator_tag iterator_category;
+        typedef ft::pair<const Key, T> value_type;
+        typedef ft::pair<const Key&, Mapped&> reference;
+        typedef std::ptrdiff_t difference_type;
+
+        struct pointer {
+            reference ref;
+
+            const reference* operator->() const {
+                return &ref;
+            }
+        };
+
+    public:
+        FlatMapIter() : _key(nullptr), _value(nullptr) {
+        }
+
+        FlatMapIter(const Key* key, Mapped* value) : _key(key), _value(value) {
+        }
+
+        /* iterator to const_iterator */
+        template<class M>
+        FlatMapIter(const FlatMapIter<Key, T, M>& other) : _key(other.key_base()), _value(other.value_base()) {
+        }
+
+        FlatMapIter(const FlatMapIter& other) : _key(other._key), _value(other._value) {
+        }
+
+        FlatMapIter& operator=(const FlatMapIter& other) {
+            if (this != &other) {
+                _key = other._key;
+                _value = other._value;
+            }
+            return *this;
+        }
+
+    public:
+        const Key* key_base() const {
+            return _key;
+        }
+
+        Mapped* value_base() const {
+            return _value;
+        }
+
+        reference operator*() const {
+            return reference(*_key, *_value);
+        }
+
+        pointer operator->() const {
+            pointer proxy = { reference(*_key, *_value) };
+            return proxy;
+        }
+
+        reference operator[](difference_type n) const {
+            return reference(_key[n], _value[n]);
+        }
+
+        FlatMapIter& operator++() {
+            ++_key;
+            ++_value;
+            return *this;
+        }
+
+        FlatMapIter operator++(int) {
+            FlatMapIter temp(*this);
+            ++(*this);
+            return temp;
+        }
+
+        FlatMapIter& operator--() {
+            --_key;
+            --_value;
+            return *this;
+        }
+
+        FlatMapIter operator--(int) {
+            FlatMapIter temp(*this);
+            --(*this);
+            return temp;
+        }
+
+        FlatMapIter& operator+=(difference_type n) {
+            _key += n;
+            _value += n;
+            return *this;
+        }
+
+        FlatMapIter& operator-=(difference_type n) {
+            _key -= n;
+            _value -= n;
+            return *this;
+        }
+
+        FlatMapIter operator+(difference_type n) const {
+            return FlatMapIter(_key + n, _value + n);
+        }
+
+        FlatMapIter operator-(difference_type n) const {
+            return FlatMapIter(_key - n, _value - n);
+        }
+
+    private:
+        const Key* _key;
+        Mapped* _value;
+    };
+
+    template<class K, class T, class M1, class M2>
+    typename FlatMapIter<K, T, M1>::difference_type operator-(const FlatMapIter<K, T, M1>& lhs, const FlatMapIter<K, T, M2>& rhs) {
+        return lhs.key_base() - rhs.key_base();
+    }
+
+    template<class K, class T, class M1, class M2>
+    bool operator==(const FlatMapIter<K, T, M1>& lhs, const FlatMapIter<K, T, M2>& rhs) {
+        return (lhs.key_base() == rhs.key_base());
+    }
+
+    template<class K, class T, class M1, class M2>
+    bool operator!=(const FlatMapIter<K, T, M1>& lhs, const FlatMapIter<K, T, M2>& rhs) {
+        return (lhs.key_base() != rhs.key_base());
+    }
+
+    template<class K, class T, class M1, class M2>
+    bool operator<(const FlatMapIter<K, T, M1>& lhs, const FlatMapIter<K, T, M2>& rhs) {
+        return (lhs.key_base() < rhs.key_base());
+    }
+
+    template<class K, class T, class M1, class M2>
+    bool operator<=(const FlatMapIter<K, T, M1>& lhs, const FlatMapIter<K, T, M2>& rhs) {
+        return (lhs.key_base() <= rhs.key_base());
+    }
+
+    template<class K, class T, class M1, class M2>
+    bool operator>(const FlatMapIter<K, T, M1>& lhs, const FlatMapIter<K, T, M2>& rhs) {
+        return (lhs.key_base() > rhs.key_base());
+    }
+
+    template<class K, class T, class M1, class M2>
+    bool operator>=(const FlatMapIter<K, T, M1>& lhs, const FlatMapIter<K, T, M2>& rhs) {
+        return (lhs.key_base() >= rhs.key_base());
+    }
+
+    template<class K, class T, class M>
+    FlatMapIter<K, T, M> operator+(typename FlatMapIter<K, T, M>::difference_type n, const FlatMapIter<K, T, M>& it) {
+        return it + n;
+    }
+
+    /* Sorted-array map: keys and mapped values in two ft::vectors, looked
+     * up by binary search over the keys alone. Built once and read many
+     * times, it takes no per-element overhead and lookups stay in a dense
+     * array. Single inserts and erases shift the tail, and any of them
+     * invalidates iterators. */
+    template<class Key, class T, class Compare = std::less<Key>, class Alloc = std::allocator<ft::pair<const Key, T> > >
+    class flat_map {
+    public:
+        typedef Key key_type;
+        typedef T mapped_type;
+        typedef ft::pair<const Key, T> value_type;
+        typedef Compare key_compare;
+        typedef Alloc allocator_type;
+        typedef typename allocator_type::size_type size_type;
+        typedef typename allocator_type::difference_type difference_type;
+        typedef ft::pair<const Key&, T&> reference;
+        typedef ft::pair<const Key&, const T&> const_reference;
+
+        typedef typename allocator_type::template rebind<Key>::other key_allocator;
+        typedef typename allocator_type::template rebind<T>::other mapped_allocator;
+        typedef ft::vector<Key, key_allocator> key_container;
+        typedef ft::vector<T, mapped_allocator> mapped_container;
+
+        typedef FlatMapIter<Key, T, T> iterator;
+        typedef FlatMapIter<Key, T, const T> const_iterator;
+        typedef typename iterator::pointer pointer;
+        typedef typename const_iterator::pointer const_pointer;
+        typedef ft::reverse_iterator<iterator> reverse_iterator;
+        typedef ft::reverse_iterator<const_iterator> const_reverse_iterator;
+
+        class value_compare {
+        public:
+            value_compare(const key_compare& cmp) : _cmp(cmp) {
+            }
+
+            bool operator()(const value_type& lhs, const value_type& rhs) const {
+                return _cmp(lhs.first, rhs.first);
+            }
+
+        private:
+            key_compare _cmp;
+        };
+
+    private:
+        /* Enables the K overloads of lookups when key_compare is transparent */
+        template<class K, class R>
+        struct _if_transparent : ft::enable_if<ft::is_transparent<key_compare>::value, R> {
+        };
+
+        /* Orders positions of a key array by their keys */
+        struct _index_compare {
+            key_compare cmp;
+            const key_type* keys;
+
+            _index_compare(const key_compare& cmp, const key_type* keys) : cmp(cmp), keys(keys) {
+            }
+
+            bool operator()(size_type lhs, size_type rhs) const {
+                return cmp(keys[lhs], keys[rhs]);
+            }
+        };
+
+    public:
+        explicit flat_map(const key_compare& comp = key_compare(), const allocator_type& alloc = allocator_type())
+                : _allocator(alloc), _cmp(comp), _keys(key_allocator(alloc)), _values(mapped_allocator(alloc)) {
+        }
+
+        template< class InputIt >
+        flat_map( InputIt first, InputIt last, const key_compare& comp = key_compare(), const allocator_type& alloc = allocator_type() )
+                : _allocator(alloc), _cmp(comp), _keys(key_allocator(alloc)), _values(mapped_allocator(alloc)) {
+            insert(first, last);
+        }
+
+        flat_map(const flat_map& other)
+                : _allocator(other._allocator), _cmp(other._cmp), _keys(other._keys), _values(other._values) {
+        }
+
+        flat_map& operator=(const flat_map& other) {
+            if (this != &other) {
+                _cmp = other._cmp;
+                _keys = other._keys;
+                _values = other._values;
+            }
+            return *this;
+        }
+
+        allocator_type get_allocator() const {
+            return _allocator;
+        }
+
+        ~flat_map() {
+        }
+
+    /* Element access */
+    public:
+        mapped_type& at(const key_type& key) {
+            size_type index = _find_index(key);
+            if (index == size()) {
+                throw std::out_of_range("No such element");
+            }
+            return _values[index];
+        }
+
+        const mapped_type& at(const key_type& key) const {
+            size_type index = _find_index(key);
+            if (index == size()) {
+                throw std::out_of_range("No such element");
+            }
+            return _values[index];
+        }
+
+        mapped_type& operator[](const key_type& key) {
+            return (*try_emplace(key).first).second;
+        }
+
+        /* The sorted keys and their values, index for index */
+        const key_container& keys() const {
+            return _keys;
+        }
+
+        const mapped_container& values() const {
+            return _values;
+        }
+
+    /* Iterators */
+    public:
+        iterator begin() {
+            return _iter(0);
+        }
+
+        const_iterator begin() const {
+            return _iter(0);
+        }
+
+        iterator end() {
+            return _iter(size());
+        }
+
+        const_iterator end() const {
+            return _iter(size());
+        }
+
+        reverse_iterator rbegin() {
+            return reverse_iterator(end());
+        }
+
+        const_reverse_iterator rbegin() const {
+            return const_reverse_iterator(end());
+        }
+
+        reverse_iterator rend() {
+            return reverse_iterator(begin());
+        }
+
+        const_reverse_iterator rend() const {
+            return const_reverse_iterator(begin());
+        }
+
+    /* Capacity */
+    public:
+        size_type size() const {
+            return _keys.size();
+        }
+
+        bool empty() const {
+            return _keys.empty();
+        }
+
+        size_type max_size() const {
+            return _keys.max_size();
+        }
+
+        void reserve(size_type count) {
+            _keys.reserve(count);
+            _values.reserve(count);
+        }
+
+        size_type capacity() const {
+            return _keys.capacity();
+        }
+
+    /* Modifiers */
+    public:
+        void clear() {
+            _keys.clear();
+            _values.clear();
+        }
+
+        ft::pair<iterator, bool> insert(const value_type& value) {
+            return try_emplace(value.first, value.second);
+        }
+
+        /* O(1) search when value belongs right before hint, then the shift */
+        iterator insert(iterator hint, const value_type& value) {
+            size_type index = hint - begin();
+            if ((index == 0 || _cmp(_keys[index - 1], value.first)) && (index == size() || _cmp(value.first, _keys[index]))) {
+                return _insert_at(index, value.first, value.second);
+            }
+            return insert(value).first;
+        }
+
+        ft::pair<iterator, bool> try_emplace(const key_type& key) {
+            size_type index = _lower_index(key);
+            if (index < size() && !_cmp(key, _keys[index])) {
+                return ft::make_pair(_iter(index), false);
+            }
+            return ft::make_pair(_insert_at(index, key, mapped_type()), true);
+        }
+
+        ft::pair<iterator, bool> try_emplace(const key_type& key, const mapped_type& obj) {
+            size_type index = _lower_index(key);
+            if (index < size() && !_cmp(key, _keys[index])) {
+                return ft::make_pair(_iter(index), false);
+            }
+            return ft::make_pair(_insert_at(index, key, obj), true);
+        }
+
+        ft::pair<iterator, bool> insert_or_assign(const key_type& key, const mapped_type& obj) {
+            size_type index = _lower_index(key);
+            if (index < size() && !_cmp(key, _keys[index])) {
+                _values[index] = obj;
+                return ft::make_pair(_iter(index), false);
+            }
+            return ft::make_pair(_insert_at(index, key, obj), true);
+        }
+
+        /* Bulk insert: the new values are sorted on their own, then merged
+         * with the current ones in a single pass, O(n + m log m) in all.
+         * Like repeated insert(), the first of equal keys wins and keys
+         * already present keep their values. */
+        template< class InputIt >
+        void insert( InputIt first, InputIt last ) {
+            key_container keys(_keys.get_allocator());
+            mapped_container values(_values.get_allocator());
+            bool sorted = true;
+            for (; first != last; ++first) {
+                if (sorted && !keys.empty()) {
+                    sorted = _cmp(keys.back(), (*first).first);
+                }
+                keys.push_back((*first).first);
+                values.push_back((*first).second);
+            }
+            if (keys.empty()) {
+                return;
+            }
+            if (!sorted) {
+                _sort_unique(keys, values);
+            }
+            _merge(keys, values);
+        }
+
+        /* Bulk load: replaces the contents with [first, last) */
+        template< class InputIt >
+        void assign( InputIt first, InputIt last ) {
+            clear();
+            insert(first, last);
+        }
+
+        void erase(iterator pos) {
+            size_type index = pos - begin();
+            _keys.erase(_keys.begin() + index);
+            _values.erase(_values.begin() + index);
+        }
+
+        size_type erase(const key_type& key) {
+            size_type index = _find_index(key);
+            if (index == size()) {
+                return 0;
+            }
+            erase(_iter(index));
+            return 1;
+        }
+
+        void erase(iterator first, iterator last) {
+            size_type from = first - begin();
+            size_type to = last - begin();
+            _keys.erase(_keys.begin() + from, _keys.begin() + to);
+            _values.erase(_values.begin() + from, _values.begin() + to);
+        }
+
+        void swap(flat_map& other) {
+            ft::swap(_allocator, other._allocator);
+            ft::swap(_cmp, other._cmp);
+            _keys.swap(other._keys);
+            _values.swap(other._values);
+        }
+
+    /* Lookup */
+    public:
+        size_type count(const key_type& key) const {
+            return (_find_index(key) != size() ? 1 : 0);
+        }
+
+        template<class K>
+        typename _if_transparent<K, size_type>::type count(const K& key) const {
+            return (_find_index(key) != size() ? 1 : 0);
+        }
+
+        iterator find(const key_type& key) {
+            return _iter(_find_index(key));
+        }
+
+        const_iterator find(const key_type& key) const {
+            return _iter(_find_index(key));
+        }
+
+        template<class K>
+        typename _if_transparent<K, iterator>::type find(const K& key) {
+            return _iter(_find_index(key));
+        }
+
+        template<class K>
+        typename _if_transparent<K, const_iterator>::type find(const K& key) const {
+            return _iter(_find_index(key));
+        }
+
+        ft::pair<iterator, iterator> equal_range(const key_type& key) {
+            return ft::make_pair(lower_bound(key), upper_bound(key));
+        }
+
+        ft::pair<const_iterator, const_iterator> equal_range(const key_type& key) const {
+            return ft::make_pair(lower_bound(key), upper_bound(key));
+        }
+
+        template<class K>
+        typename _if_transparent<K, ft::pair<iterator, iterator> >::type equal_range(const K& key) {
+            return ft::make_pair(_iter(_lower_index(key)), _iter(_upper_index(key)));
+        }
+
+        template<class K>
+        typename _if_transparent<K, ft::pair<const_iterator, const_iterator> >::type equal_range(const K& key) const {
+            return ft::make_pair(_iter(_lower_index(key)), _iter(_upper_index(key)));
+        }
+
+        iterator lower_bound(const key_type& key) {
+            return _iter(_lower_index(key));
+        }
+
+        const_iterator lower_bound(const key_type& key) const {
+            return _iter(_lower_index(key));
+        }
+
+        template<class K>
+        typename _if_transparent<K, iterator>::type lower_bound(const K& key) {
+            return _iter(_lower_index(key));
+        }
+
+        template<class K>
+        typename _if_transparent<K, const_iterator>::type lower_bound(const K& key) const {
+            return _iter(_lower_index(key));
+        }
+
+        iterator upper_bound(const key_type& key) {
+            return _iter(_upper_index(key));
+        }
+
+        const_iterator upper_bound(const key_type& key) const {
+            return _iter(_upper_index(key));
+        }
+
+        template<class K>
+        typename _if_transparent<K, iterator>::type upper_bound(const K& key) {
+            return _iter(_upper_index(key));
+        }
+
+        template<class K>
+        typename _if_transparent<K, const_iterator>::type upper_bound(const K& key) const {
+            return _iter(_upper_index(key));
+        }
+
+    /* Observers */
+    public:
+        key_compare key_comp() {
+            return _cmp;
+        }
+
+        value_compare value_comp() {
+            return value_compare(_cmp);
+        }
+
+    /* private helpers */
+    private:
+        iterator _iter(size_type index) {
+            return iterator(_keys.data() + index, _values.data() + index);
+        }
+
+        const_iterator _iter(size_type index) const {
+            return const_iterator(_keys.data() + index, _values.data() + index);
+        }
+
+        /* First index whose key is not less than key */
+        template<class K>
+        size_type _lower_index(const K& key) const {
+            const key_type* keys = _keys.data();
+            size_type first = 0;
+            size_type count = _keys.size();
+            while (count > 0) {
+                size_type half = count / 2;
+                if (_cmp(keys[first + half], key)) {
+                    first += half + 1;
+                    count -= half + 1;
+                } else {
+                    count = half;
+                }
+            }
+            return first;
+        }
+
+        /* First index whose key is greater than key */
+        template<class K>
+        size_type _upper_index(const K& key) const {
+            const key_type* keys = _keys.data();
+            size_type first = 0;
+            size_type count = _keys.size();
+            while (count > 0) {
+                size_type half = count / 2;
+                if (!_cmp(key, keys[first + half])) {
+                    first += half + 1;
+                    count -= half + 1;
+                } else {
+                    count = half;
+                }
+            }
+            return first;
+        }
+
+        /* Index of key, or size() */
+        template<class K>
+        size_type _find_index(const K& key) const {
+            size_type index = _lower_index(key);
+            if (index < size() && !_cmp(key, _keys[index])) {
+                return index;
+            }
+            return size();
+        }
+
+        iterator _insert_at(size_type index, const key_type& key, const mapped_type& obj) {
+            _keys.insert(_keys.begin() + index, key);
+            _values.insert(_values.begin() + index, obj);
+            return _iter(index);
+        }
+
+        /* Stable sort through an index permutation, keeping the first of equal keys */
+        void _sort_unique(key_container& keys, mapped_container& values) const {
+            ft::vector<size_type> order;
+            order.reserve(keys.size());
+            for (size_type i = 0; i < keys.size(); ++i) {
+                order.push_back(i);
+            }
+            ft::stable_sort(order.begin(), order.end(), _index_compare(_cmp, keys.data()));
+            key_container sorted_keys(keys.get_allocator());
+            mapped_container sorted_values(values.get_allocator());
+            sorted_keys.reserve(keys.size());
+            sorted_values.reserve(values.size());
+            for (size_type i = 0; i < order.size(); ++i) {
+                if (sorted_keys.empty() || _cmp(sorted_keys.back(), keys[order[i]])) {
+                    sorted_keys.push_back(keys[order[i]]);
+                    sorted_values.push_back(values[order[i]]);
+                }
+            }
+            keys.swap(sorted_keys);
+            values.swap(sorted_values);
+        }
+
+        /* Merges sorted unique keys into the contents, present keys winning */
+        void _merge(key_container& keys, mapped_container& values) {
+            if (empty()) {
+                _keys.swap(keys);
+                _values.swap(values);
+                return;
+            }
+            if (_cmp(_keys.back(), keys.front())) {
+                reserve(size() + keys.size());
+                for (size_type i = 0; i < keys.size(); ++i) {
+                    _keys.push_back(keys[i]);
+                    _values.push_back(values[i]);
+                }
+                return;
+            }
+            key_container merged_keys(_keys.get_allocator());
+            mapped_container merged_values(_values.get_allocator());
+            merged_keys.reserve(size() + keys.size());
+            merged_values.reserve(size() + keys.size());
+            size_type i = 0;
+            size_type j = 0;
+            while (i < size() && j < keys.size()) {
+                if (_cmp(keys[j], _keys[i])) {
+                    merged_keys.push_back(keys[j]);
+                    merged_values.push_back(values[j]);
+                    ++j;
+                } else {
+                    if (!_cmp(_keys[i], keys[j])) {
+                        ++j;
+                    }
+                    merged_keys.push_back(_keys[i]);
+                    merged_values.push_back(_values[i]);
+                    ++i;
+                }
+            }
+            for (; i < size(); ++i) {
+                merged_keys.push_back(_keys[i]);
+                merged_values.push_back(_values[i]);
+            }
+            for (; j < keys.size(); ++j) {
+                merged_keys.push_back(keys[j]);
+                merged_values.push_back(values[j]);
+            }
+            _keys.swap(merged_keys);
+            _values.swap(merged_values);
+        }
+
+    private:
+        allocator_type _allocator;
+        key_compare _cmp;
+        key_container _keys;
+        mapped_container _values;
+    };
+
+    template< class Key, class T, class Compare, class Alloc >
+    bool operator==(const ft::flat_map<Key, T, Compare, Alloc>& lhs,
+                    const ft::flat_map<Key, T, Compare, Alloc>& rhs ) {
+        return (lhs.keys() == rhs.keys() && lhs.values() == rhs.values());
+    }
+
+    template< class Key, class T, class Compare, class Alloc >
+    bool operator!=(const ft::flat_map<Key, T, Compare, Alloc>& lhs,
+                    const ft::flat_map<Key, T, Compare, Alloc>& rhs ) {
+        return !(lhs == rhs);
+    }
+
+    template< class Key, class T, class Compare, class Alloc >
+    bool operator<(const ft::flat_map<Key, T, Compare, Alloc>& lhs,
+                    const ft::flat_map<Key, T, Compare, Alloc>& rhs ) {
+        return ft::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+    }
+
+    template< class Key, class T, class Compare, class Alloc >
+    bool operator<=(const ft::flat_map<Key, T, Compare, Alloc>& lhs,
+                    const ft::flat_map<Key, T, Compare, Alloc>& rhs ) {
+        return (lhs == rhs || lhs < rhs);
+    }
+
+    template< class Key, class T, class Compare, class Alloc >
+    bool operator>(const ft::flat_map<Key, T, Compare, Alloc>& lhs,
+                    const ft::flat_map<Key, T, Compare, Alloc>& rhs ) {
+        return !(lhs <= rhs);
+    }
+
+    template< class Key, class T, class Compare, class Alloc >
+    bool operator>=(const ft::flat_map<Key, T, Compare, Alloc>& lhs,
+                    const ft::flat_map<Key, T, Compare, Alloc>& rhs ) {
+        return !(lhs < rhs);
+    }
+
+    template< class Key, class T, class Compare, class Alloc >
+    void swap(ft::flat_map<Key, T, Compare, Alloc>& lhs, ft::flat_map<Key, T, Compare, Alloc>& rhs) {
+        lhs.swap(rhs);
+    }
+
+} //namespace ft
@@ -0,0 +1,382 @@
+#pragma once
+
+#include <memory>
+
+#include "iterators.hpp"
+#include "iterators_traits.hpp"
+#include "algorithm.hpp"
+#include "pair.hpp"
+#include "vector.hpp"
+
+namespace ft {
+
+    /* Sorted-array set on one ft::vector, looked up by binary search. Same
+     * trade-offs as ft::flat_map: dense and fast to read, single inserts and
+     * erases shift the tail and invalidate iterators. */
+    template<class Key, class Compare = std::less<Key>, class Alloc = std::allocator<Key> >
+    class flat_set {
+    public:
+        typedef Key key_type;
+        typedef Key value_type;
+        typedef Compare key_compare;
+        typedef Compare value_compare;
+        typedef Alloc allocator_type;
+        typedef ft::vector<Key, Alloc> container_type;
+        typedef typename allocator_type::size_type size_type;
+        typedef typename allocator_type::difference_type difference_type;
+        typedef typename allocator_type::const_reference reference;
+        typedef typename allocator_type::const_reference const_reference;
+        typedef typename allocator_type::const_pointer pointer;
+        typedef typename allocator_type::const_pointer const_pointer;
+        typedef typename container_type::const_iterator iterator;
+        typedef typename container_type::const_iterator const_iterator;
+        typedef ft::reverse_iterator<iterator> reverse_iterator;
+        typedef ft::reverse_iterator<const_iterator> const_reverse_iterator;
+
+    private:
+        /* Enables the K overloads of lookups when key_compare is transparent */
+        template<class K, class R>
+        struct _if_transparent : ft::enable_if<ft::is_transparent<key_compare>::value, R> {
+        };
+
+    public:
+        explicit flat_set(const key_compare& comp = key_compare(), const allocator_type& alloc = allocator_type())
+                : _cmp(comp), _keys(alloc) {
+        }
+
+        template< class InputIt >
+        flat_set( InputIt first, InputIt last, const key_compare& comp = key_compare(), const allocator_type& alloc = allocator_type() )
+                : _cmp(comp), _keys(alloc) {
+            insert(first, last);
+        }
+
+        flat_set(const flat_set& other) : _cmp(other._cmp), _keys(other._keys) {
+        }
+
+        flat_set& operator=(const flat_set& other) {
+            if (this != &other) {
+                _cmp = other._cmp;
+                _keys = other._keys;
+            }
+            return *this;
+        }
+
+        allocator_type get_allocator() const {
+            return _keys.get_allocator();
+        }
+
+        ~flat_set() {
+        }
+
+        /* The sorted keys */
+        const container_type& keys() const {
+            return _keys;
+        }
+
+    /* Iterators */
+    public:
+        const_iterator begin() const {
+            return _keys.begin();
+        }
+
+        const_iterator end() const {
+            return _keys.end();
+        }
+
+        const_reverse_iterator rbegin() const {
+            return const_reverse_iterator(end());
+        }
+
+        const_reverse_iterator rend() const {
+            return const_reverse_iterator(begin());
+        }
+
+    /* Capacity */
+    public:
+        size_type size() const {
+            return _keys.size();
+        }
+
+        bool empty() const {
+            return _keys.empty();
+        }
+
+        size_type max_size() const {
+            return _keys.max_size();
+        }
+
+        void reserve(size_type count) {
+            _keys.reserve(count);
+        }
+
+        size_type capacity() const {
+            return _keys.capacity();
+        }
+
+    /* Modifiers */
+    public:
+        void clear() {
+            _keys.clear();
+        }
+
+        ft::pair<iterator, bool> insert(const value_type& value) {
+            size_type index = _lower_index(value);
+            if (index < size() && !_cmp(value, _keys[index])) {
+                return ft::make_pair(_iter(index), false);
+            }
+            _keys.insert(_keys.begin() + index, value);
+            return ft::make_pair(_iter(index), true);
+        }
+
+        iterator insert(iterator hint, const value_type& value) {
+            size_type index = _index(hint);
+            if ((index == 0 || _cmp(_keys[index - 1], value)) && (index == size() || _cmp(value, _keys[index]))) {
+                _keys.insert(_keys.begin() + index, value);
+                return _iter(index);
+            }
+            return insert(value).first;
+        }
+
+        /* Bulk insert: sorts the new keys on their own and merges them in
+         * one pass, O(n + m log m). The first of equal keys wins. */
+        template< class InputIt >
+        void insert( InputIt first, InputIt last ) {
+            container_type keys(_keys.get_allocator());
+            bool sorted = true;
+            for (; first != last; ++first) {
+                if (sorted && !keys.empty()) {
+                    sorted = _cmp(keys.back(), *first);
+                }
+                keys.push_back(*first);
+            }
+            if (keys.empty()) {
+                return;
+            }
+            if (!sorted) {
+                ft::stable_sort(keys.begin(), keys.end(), _cmp);
+                size_type count = 1;
+                for (size_type i = 1; i < keys.size(); ++i) {
+                    if (_cmp(keys[count - 1], keys[i])) {
+                        keys[count++] = keys[i];
+                    }
+                }
+                keys.erase(keys.begin() + count, keys.end());
+            }
+            _merge(keys);
+        }
+
+        template< class InputIt >
+        void assign( InputIt first, InputIt last ) {
+            clear();
+            insert(first, last);
+        }
+
+        void erase(iterator pos) {
+            _keys.erase(_keys.begin() + _index(pos));
+        }
+
+        size_type erase(const key_type& key) {
+            size_type index = _find_index(key);
+            if (index == size()) {
+                return 0;
+            }
+            _keys.erase(_keys.begin() + index);
+            return 1;
+        }
+
+        void erase(iterator first, iterator last) {
+            _keys.erase(_keys.begin() + _index(first), _keys.begin() + _index(last));
+        }
+
+        void swap(flat_set& other) {
+            ft::swap(_cmp, other._cmp);
+            _keys.swap(other._keys);
+        }
+
+    /* Lookup */
+    public:
+        size_type count(const key_type& key) const {
+            return (_find_index(key) != size() ? 1 : 0);
+        }
+
+        template<class K>
+        typename _if_transparent<K, size_type>::type count(const K& key) const {
+            return (_find_index(key) != size() ? 1 : 0);
+        }
+
+        const_iterator find(const key_type& key) const {
+            return _iter(_find_index(key));
+        }
+
+        template<class K>
+        typename _if_transparent<K, const_iterator>::type find(const K& key) const {
+            return _iter(_find_index(key));
+        }
+
+        ft::pair<const_iterator, const_iterator> equal_range(const key_type& key) const {
+            return ft::make_pair(lower_bound(key), upper_bound(key));
+        }
+
+        template<class K>
+        typename _if_transparent<K, ft::pair<const_iterator, const_iterator> >::type equal_range(const K& key) const {
+            return ft::make_pair(_iter(_lower_index(key)), _iter(_upper_index(key)));
+        }
+
+        const_iterator lower_bound(const key_type& key) const {
+            return _iter(_lower_index(key));
+        }
+
+        template<class K>
+        typename _if_transparent<K, const_iterator>::type lower_bound(const K& key) const {
+            return _iter(_lower_index(key));
+        }
+
+        const_iterator upper_bound(const key_type& key) const {
+            return _iter(_upper_index(key));
+        }
+
+        template<class K>
+        typename _if_transparent<K, const_iterator>::type upper_bound(const K& key) const {
+            return _iter(_upper_index(key));
+        }
+
+    /* Observers */
+    public:
+        key_compare key_comp() const {
+            return _cmp;
+        }
+
+        value_compare value_comp() const {
+            return _cmp;
+        }
+
+    /* private helpers */
+    private:
+        const_iterator _iter(size_type index) const {
+            return const_iterator(_keys.data() + index);
+        }
+
+        size_type _index(const_iterator pos) const {
+            return pos.operator->() - _keys.data();
+        }
+
+        template<class K>
+        size_type _lower_index(const K& key) const {
+            const key_type* keys = _keys.data();
+            size_type first = 0;
+            size_type count = _keys.size();
+            while (count > 0) {
+                size_type half = count / 2;
+                if (_cmp(keys[first + half], key)) {
+                    first += half + 1;
+                    count -= half + 1;
+                } else {
+                    count = half;
+                }
+            }
+            return first;
+        }
+
+        template<class K>
+        size_type _upper_index(const K& key) const {
+            const key_type* keys = _keys.data();
+            size_type first = 0;
+            size_type count = _keys.size();
+            while (count > 0) {
+                size_type half = count / 2;
+                if (!_cmp(key, keys[first + half])) {
+                    first += half + 1;
+                    count -= half + 1;
+                } else {
+                    count = half;
+                }
+            }
+            return first;
+        }
+
+        template<class K>
+        size_type _find_index(const K& key) const {
+            size_type index = _lower_index(key);
+            if (index < size() && !_cmp(key, _keys[index])) {
+                return index;
+            }
+            return size();
+        }
+
+        /* Merges sorted unique keys into the contents */
+        void _merge(container_type& keys) {
+            if (empty()) {
+                _keys.swap(keys);
+                return;
+            }
+            if (_cmp(_keys.back(), keys.front())) {
+                _keys.reserve(size() + keys.size());
+                for (size_type i = 0; i < keys.size(); ++i) {
+                    _keys.push_back(keys[i]);
+                }
+                return;
+            }
+            container_type merged(_keys.get_allocator());
+            merged.reserve(size() + keys.size());
+            size_type i = 0;
+            size_type j = 0;
+            while (i < size() && j < keys.size()) {
+                if (_cmp(keys[j], _keys[i])) {
+                    merged.push_back(keys[j++]);
+                } else {
+                    if (!_cmp(_keys[i], keys[j])) {
+                        ++j;
+                    }
+                    merged.push_back(_keys[i++]);
+                }
+            }
+            for (; i < size(); ++i) {
+                merged.push_back(_keys[i]);
+            }
+            for (; j < keys.size(); ++j) {
+                merged.push_back(keys[j]);
+            }
+            _keys.swap(merged);
+        }
+
+    private:
+        key_compare _cmp;
+        container_type _keys;
+    };
+
+    template< class Key, class Compare, class Alloc >
+    bool operator==(const ft::flat_set<Key, Compare, Alloc>& lhs, const ft::flat_set<Key, Compare, Alloc>& rhs) {
+        return (lhs.keys() == rhs.keys());
+    }
+
+    template< class Key, class Compare, class Alloc >
+    bool operator!=(const ft::flat_set<Key, Compare, Alloc>& lhs, const ft::flat_set<Key, Compare, Alloc>& rhs) {
+        return !(lhs == rhs);
+    }
+
+    template< class Key, class Compare, class Alloc >
+    bool operator<(const ft::flat_set<Key, Compare, Alloc>& lhs, const ft::flat_set<Key, Compare, Alloc>& rhs) {
+        return (lhs.keys() < rhs.keys());
+    }
+
+    template< class Key, class Compare, class Alloc >
+    bool operator<=(const ft::flat_set<Key, Compare, Alloc>& lhs, const ft::flat_set<Key, Compare, Alloc>& rhs) {
+        return (lhs == rhs || lhs < rhs);
+    }
+
+    template< class Key, class Compare, class Alloc >
+    bool operator>(const ft::flat_set<Key, Compare, Alloc>& lhs, const ft::flat_set<Key, Compare, Alloc>& rhs) {
+        return !(lhs <= rhs);
+    }
+
+    template< class Key, class Compare, class Alloc >
+    bool operator>=(const ft::flat_set<Key, Compare, Alloc>& lhs, const ft::flat_set<Key, Compare, Alloc>& rhs) {
+        return !(lhs < rhs);
+    }
+
+    template< class Key, class Compare, class Alloc >
+    void swap(ft::flat_set<Key, Compare, Alloc>& lhs, ft::flat_set<Key, Compare, Alloc>& rhs) {
+        lhs.swap(rhs);
+    }
+
+} //namespace ft
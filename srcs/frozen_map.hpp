@@ -0,0 +1,471 @@
+#pragma once
+
+#include <memory>
+#include <stdexcept>
+
+#include "iterators.hpp"
+#include "iterators_traits.hpp"
+#include "algorithm.hpp"
+#include "pair.hpp"
+#include "vector.hpp"
+#include "flat_map.hpp"
+
+namespace ft {
+
+    /* Position arithmetic of an Eytzinger array: a complete binary search
+     * tree stored breadth first from index 1, the children of k at 2k and
+     * 2k + 1. Index 0 is the end. */
+    struct Eytzinger {
+        /* Leftmost and rightmost of a tree of size elements */
+        static size_t first(size_t size) {
+            size_t k = (size ? 1 : 0);
+            while (k && 2 * k <= size) {
+                k = 2 * k;
+            }
+            return k;
+        }
+
+        static size_t last(size_t size) {
+            size_t k = (size ? 1 : 0);
+            while (k && 2 * k + 1 <= size) {
+                k = 2 * k + 1;
+            }
+            return k;
+        }
+
+        /* In-order neighbours, O(1) amortized over a walk */
+        static size_t next(size_t k, size_t size) {
+            if (2 * k + 1 <= size) {
+                k = 2 * k + 1;
+                while (2 * k <= size) {
+                    k = 2 * k;
+                }
+                return k;
+            }
+            while (k & 1) {
+                k >>= 1;
+            }
+            return (k >> 1);
+        }
+
+        static size_t prev(size_t k, size_t size) {
+            if (k == 0) {
+                return last(size);
+            }
+            if (2 * k <= size) {
+                k = 2 * k;
+                while (2 * k + 1 <= size) {
+                    k = 2 * k + 1;
+                }
+                return k;
+            }
+            while (k && !(k & 1)) {
+                k >>= 1;
+            }
+            return (k >> 1);
+        }
+
+        /* The search went right at every level below its answer, and then
+         * left once: drop those steps to get back to it */
+        static size_t settle(size_t k) {
+            return (k >> (__builtin_ctzl(~k) + 1));
+        }
+    };
+
+    /* frozen_map iterator: walks the key and the mapped arrays in key order,
+     * which is in-order through the Eytzinger tree */
+    template<class Key, class T>
+    class FrozenMapIter {
+    public:
+        typedef ft::bidirectional_iterator_tag iterator_category;
+        typedef ft::pair<const Key, T> value_type;
+        typedef ft::pair<const Key&, const T&> reference;
+        typedef std::ptrdiff_t difference_type;
+
+        struct pointer {
+            reference ref;
+
+            const reference* operator->() const {
+                return &ref;
+            }
+        };
+
+    public:
+        FrozenMapIter() : _keys(nullptr), _values(nullptr), _index(0), _size(0) {
+        }
+
+        FrozenMapIter(const Key* keys, const T* values, size_t index, size_t size)
+                : _keys(keys), _values(values), _index(index), _size(size) {
+        }
+
+        FrozenMapIter(const FrozenMapIter& other)
+                : _keys(other._keys), _values(other._values), _index(other._index), _size(other._size) {
+        }
+
+        FrozenMapIter& operator=(const FrozenMapIter& other) {
+            if (this != &other) {
+                _keys = other._keys;
+                _values = other._values;
+                _index = other._index;
+                _size = other._size;
+            }
+            return *this;
+        }
+
+    public:
+        /* Position in the Eytzinger arrays, 0 for end() */
+        size_t index() const {
+            return _index;
+        }
+
+        reference operator*() const {
+            return reference(_keys[_index], _values[_index]);
+        }
+
+        pointer operator->() const {
+            pointer proxy = { reference(_keys[_index], _values[_index]) };
+            return proxy;
+        }
+
+        FrozenMapIter& operator++() {
+            _index = Eytzinger::next(_index, _size);
+            return *this;
+        }
+
+        FrozenMapIter operator++(int) {
+            FrozenMapIter temp(*this);
+            ++(*this);
+            return temp;
+        }
+
+        FrozenMapIter& operator--() {
+            _index = Eytzinger::prev(_index, _size);
+            return *this;
+        }
+
+        FrozenMapIter operator--(int) {
+            FrozenMapIter temp(*this);
+            --(*this);
+            return temp;
+        }
+
+    private:
+        const Key* _keys;
+        const T* _values;
+        size_t _index;
+        size_t _size;
+    };
+
+    template<class K, class T>
+    bool operator==(const FrozenMapIter<K, T>& lhs, const FrozenMapIter<K, T>& rhs) {
+        return (lhs.index() == rhs.index());
+    }
+
+    template<class K, class T>
+    bool operator!=(const FrozenMapIter<K, T>& lhs, const FrozenMapIter<K, T>& rhs) {
+        return (lhs.index() != rhs.index());
+    }
+
+    /* Read-only map for tables built once: keys in an Eytzinger array, the
+     * mapped values in a second one at the same positions. The first levels
+     * of the tree share the first cache lines, and the 2^d descendants d
+     * levels below a key sit next to each other, so a search prefetches
+     * the line it will need four levels ahead and never waits on more than
+     * a few misses. Each step is a comparison added to the index, without
+     * a branch. No per-element overhead beyond the two arrays.
+     *
+     * Built in O(n) from sorted input, any ft::map or sorted range of pairs;
+     * other input is sorted first, the first of equal keys kept. It can also
+     * view arrays already in this layout, such as a mapped ft::snapshot,
+     * without copying them. */
+    template<class Key, class T, class Compare = std::less<Key>, class Alloc = std::allocator<ft::pair<const Key, T> > >
+    class frozen_map {
+    public:
+        typedef Key key_type;
+        typedef T mapped_type;
+        typedef ft::pair<const Key, T> value_type;
+        typedef Compare key_compare;
+        typedef Alloc allocator_type;
+        typedef typename allocator_type::size_type size_type;
+        typedef typename allocator_type::difference_type difference_type;
+        typedef ft::pair<const Key&, const T&> const_reference;
+
+        typedef typename allocator_type::template rebind<Key>::other key_allocator;
+        typedef typename allocator_type::template rebind<T>::other mapped_allocator;
+        typedef ft::vector<Key, key_allocator> key_container;
+        typedef ft::vector<T, mapped_allocator> mapped_container;
+
+        typedef FrozenMapIter<Key, T> const_iterator;
+        typedef const_iterator iterator;
+        typedef typename const_iterator::pointer const_pointer;
+        typedef ft::reverse_iterator<const_iterator> const_reverse_iterator;
+        typedef const_reverse_iterator reverse_iterator;
+
+    private:
+        /* Enables the K overloads of lookups when key_compare is transparent */
+        template<class K, class R>
+        struct _if_transparent : ft::enable_if<ft::is_transparent<key_compare>::value, R> {
+        };
+
+        /* Keys per cache line, rounded down to a power of two: the
+         * descendants four levels down fill one line for 4-byte keys */
+        enum {
+            _line = 64,
+            _stride = (_line / sizeof(Key) >= 16 ? 16 : _line / sizeof(Key) >= 8 ? 8 :
+                       _line / sizeof(Key) >= 4 ? 4 : _line / sizeof(Key) >= 2 ? 2 : 1)
+        };
+
+    public:
+        explicit frozen_map(const key_compare& comp = key_compare(), const allocator_type& alloc = allocator_type())
+                : _allocator(alloc), _cmp(comp), _keys(1, key_type(), key_allocator(alloc)),
+                  _values(1, mapped_type(), mapped_allocator(alloc)), _size(0) {
+            _attach();
+        }
+
+        template< class InputIt >
+        frozen_map( InputIt first, InputIt last, const key_compare& comp = key_compare(), const allocator_type& alloc = allocator_type() )
+                : _allocator(alloc), _cmp(comp), _keys(key_allocator(alloc)), _values(mapped_allocator(alloc)), _size(0) {
+            flat_map<Key, T, Compare, Alloc> sorted(first, last, comp, alloc);
+            _build(sorted.keys(), sorted.values());
+        }
+
+        /* View of Eytzinger arrays of size + 1 entries laid out elsewhere,
+         * index 0 unused. Nothing is copied: the arrays must outlive the map
+         * and its copies. */
+        frozen_map(const key_type* keys, const mapped_type* values, size_type size,
+                   const key_compare& comp = key_compare(), const allocator_type& alloc = allocator_type())
+                : _allocator(alloc), _cmp(comp), _keys(key_allocator(alloc)), _values(mapped_allocator(alloc)),
+                  _size(size), _key_data(keys), _value_data(values) {
+        }
+
+        frozen_map(const frozen_map& other)
+                : _allocator(other._allocator), _cmp(other._cmp), _keys(other._keys), _values(other._values), _size(other._size) {
+            _attach(other);
+        }
+
+        frozen_map& operator=(const frozen_map& other) {
+            if (this != &other) {
+                _cmp = other._cmp;
+                _keys = other._keys;
+                _values = other._values;
+                _size = other._size;
+                _attach(other);
+            }
+            return *this;
+        }
+
+        allocator_type get_allocator() const {
+            return _allocator;
+        }
+
+        ~frozen_map() {
+        }
+
+    /* Element access */
+    public:
+        const mapped_type& at(const key_type& key) const {
+            size_type index = _find_index(key);
+            if (index == 0) {
+                throw std::out_of_range("No such element");
+            }
+            return _value_data[index];
+        }
+
+    /* Iterators */
+    public:
+        const_iterator begin() const {
+            return _iter(Eytzinger::first(_size));
+        }
+
+        const_iterator end() const {
+            return _iter(0);
+        }
+
+        const_reverse_iterator rbegin() const {
+            return const_reverse_iterator(end());
+        }
+
+        const_reverse_iterator rend() const {
+            return const_reverse_iterator(begin());
+        }
+
+    /* Capacity */
+    public:
+        size_type size() const {
+            return _size;
+        }
+
+        bool empty() const {
+            return (_size == 0);
+        }
+
+        void swap(frozen_map& other) {
+            ft::swap(_allocator, other._allocator);
+            ft::swap(_cmp, other._cmp);
+            _keys.swap(other._keys);
+            _values.swap(other._values);
+            ft::swap(_size, other._size);
+            ft::swap(_key_data, other._key_data);
+            ft::swap(_value_data, other._value_data);
+        }
+
+    /* Lookup */
+    public:
+        size_type count(const key_type& key) const {
+            return (_find_index(key) != 0 ? 1 : 0);
+        }
+
+        template<class K>
+        typename _if_transparent<K, size_type>::type count(const K& key) const {
+            return (_find_index(key) != 0 ? 1 : 0);
+        }
+
+        const_iterator find(const key_type& key) const {
+            return _iter(_find_index(key));
+        }
+
+        template<class K>
+        typename _if_transparent<K, const_iterator>::type find(const K& key) const {
+            return _iter(_find_index(key));
+        }
+
+        ft::pair<const_iterator, const_iterator> equal_range(const key_type& key) const {
+            return ft::make_pair(lower_bound(key), upper_bound(key));
+        }
+
+        const_iterator lower_bound(const key_type& key) const {
+            return _iter(_lower_index(key));
+        }
+
+        template<class K>
+        typename _if_transparent<K, const_iterator>::type lower_bound(const K& key) const {
+            return _iter(_lower_index(key));
+        }
+
+        const_iterator upper_bound(const key_type& key) const {
+            return _iter(_upper_index(key));
+        }
+
+        template<class K>
+        typename _if_transparent<K, const_iterator>::type upper_bound(const K& key) const {
+            return _iter(_upper_index(key));
+        }
+
+    /* Observers */
+    public:
+        key_compare key_comp() const {
+            return _cmp;
+        }
+
+        /* Keys and their values by Eytzinger position, size() + 1 of each,
+         * index 0 unused */
+        const key_type* keys() const {
+            return _key_data;
+        }
+
+        const mapped_type* values() const {
+            return _value_data;
+        }
+
+    /* private helpers */
+    private:
+        const_iterator _iter(size_type index) const {
+            return const_iterator(_key_data, _value_data, index, _size);
+        }
+
+        /* Points the lookups at the owned arrays, or at the arrays other
+         * views when it owns none */
+        void _attach() {
+            _key_data = _keys.data();
+            _value_data = _values.data();
+        }
+
+        void _attach(const frozen_map& other) {
+            if (other._keys.empty()) {
+                _key_data = other._key_data;
+                _value_data = other._value_data;
+            } else {
+                _attach();
+            }
+        }
+
+        /* Lays sorted unique keys out in Eytzinger order with an in-order
+         * walk of the positions, O(n) */
+        void _build(const key_container& keys, const mapped_container& values) {
+            _size = keys.size();
+            key_container laid_keys(_size + 1, key_type(), keys.get_allocator());
+            mapped_container laid_values(_size + 1, mapped_type(), values.get_allocator());
+            size_type k = Eytzinger::first(_size);
+            for (size_type i = 0; i < _size; ++i) {
+                laid_keys[k] = keys[i];
+                laid_values[k] = values[i];
+                k = Eytzinger::next(k, _size);
+            }
+            _keys.swap(laid_keys);
+            _values.swap(laid_values);
+            _attach();
+        }
+
+        /* Position of the first key not less than key, 0 if none */
+        template<class K>
+        size_type _lower_index(const K& key) const {
+            const key_type* keys = _key_data;
+            size_type k = 1;
+            while (k <= _size) {
+                __builtin_prefetch(keys + k * _stride);
+                k = 2 * k + _cmp(keys[k], key);
+            }
+            return Eytzinger::settle(k);
+        }
+
+        /* Position of the first key greater than key, 0 if none */
+        template<class K>
+        size_type _upper_index(const K& key) const {
+            const key_type* keys = _key_data;
+            size_type k = 1;
+            while (k <= _size) {
+                __builtin_prefetch(keys + k * _stride);
+                k = 2 * k + !_cmp(key, keys[k]);
+            }
+            return Eytzinger::settle(k);
+        }
+
+        /* Position of key, 0 if absent */
+        template<class K>
+        size_type _find_index(const K& key) const {
+            size_type index = _lower_index(key);
+            if (index != 0 && !_cmp(key, _key_data[index])) {
+                return index;
+            }
+            return 0;
+        }
+
+    private:
+        allocator_type _allocator;
+        key_compare _cmp;
+        key_container _keys;
+        mapped_container _values;
+        size_type _size;
+        const key_type* _key_data;
+        const mapped_type* _value_data;
+    };
+
+    template< class Key, class T, class Compare, class Alloc >
+    bool operator==(const ft::frozen_map<Key, T, Compare, Alloc>& lhs,
+                    const ft::frozen_map<Key, T, Compare, Alloc>& rhs ) {
+        return (ft::equal(lhs.keys() + 1, lhs.keys() + lhs.size() + 1, rhs.keys() + 1, rhs.keys() + rhs.size() + 1)
+                && ft::equal(lhs.values() + 1, lhs.values() + lhs.size() + 1, rhs.values() + 1, rhs.values() + rhs.size() + 1));
+    }
+
+    template< class Key, class T, class Compare, class Alloc >
+    bool operator!=(const ft::frozen_map<Key, T, Compare, Alloc>& lhs,
+                    const ft::frozen_map<Key, T, Compare, Alloc>& rhs ) {
+        return !(lhs == rhs);
+    }
+
+    template< class Key, class T, class Compare, class Alloc >
+    void swap(ft::frozen_map<Key, T, Compare, Alloc>& lhs, ft::frozen_map<Key, T, Compare, Alloc>& rhs) {
+        lhs.swap(rhs);
+    }
+
+} //namespace ft
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <cstddef>
+#include <cstring>
+#include <string>
+
+namespace ft {
+
+    /* Hash functors for ft::unordered_map and ft::unordered_set. Integers
+     * and pointers hash to themselves: the table mixes every hash before
+     * using it, so they need no scrambling here. */
+    template<class T>
+    struct hash;
+
+    template<class T>
+    struct hash<T*> {
+        size_t operator()(T* ptr) const {
+            return reinterpret_cast<size_t>(ptr);
+        }
+    };
+
+    template<class T>
+    struct _integral_hash {
+        size_t operator()(T value) const {
+            return static_cast<size_t>(value);
+        }
+    };
+
+    template<> struct hash<bool> : public _integral_hash<bool> {};
+    template<> struct hash<char> : public _integral_hash<char> {};
+    template<> struct hash<signed char> : public _integral_hash<signed char> {};
+    template<> struct hash<unsigned char> : public _integral_hash<unsigned char> {};
+    template<> struct hash<wchar_t> : public _integral_hash<wchar_t> {};
+    template<> struct hash<short> : public _integral_hash<short> {};
+    template<> struct hash<unsigned short> : public _integral_hash<unsigned short> {};
+    template<> struct hash<int> : public _integral_hash<int> {};
+    template<> struct hash<unsigned int> : public _integral_hash<unsigned int> {};
+    template<> struct hash<long> : public _integral_hash<long> {};
+    template<> struct hash<unsigned long> : public _integral_hash<unsigned long> {};
+    template<> struct hash<long long> : public _integral_hash<long long> {};
+    template<> struct hash<unsigned long long> : public _integral_hash<unsigned long long> {};
+
+    /* Bytes taken eight at a time, each word folded in with a multiply */
+    inline size_t hash_bytes(const void* data, size_t length) {
+        const unsigned char* bytes = static_cast<const unsigned char*>(data);
+        unsigned long long hash = 0xcbf29ce484222325ULL ^ length;
+        for (; length >= 8; bytes += 8, length -= 8) {
+            unsigned long long word;
+            std::memcpy(&word, bytes, 8);
+            hash = (hash ^ word) * 0x9e3779b97f4a7c15ULL;
+            hash ^= hash >> 29;
+        }
+        unsigned long long tail = 0;
+        std::memcpy(&tail, bytes, length);
+        hash = (hash ^ tail) * 0x9e3779b97f4a7c15ULL;
+        return static_cast<size_t>(hash ^ (hash >> 32));
+    }
+
+    template<>
+    struct hash<std::string> {
+        size_t operator()(const std::string& value) const {
+            return hash_bytes(value.data(), value.size());
+        }
+    };
+
+} //namespace ft
@@ -164,11 +164,14 @@ namespace ft {
 
             }
 
+            template<class T>
+            reverse_iterator(const reverse_iterator<T>& oth) : _iter(oth.base()) {
+
+            }
+
             template<class T>
             reverse_iterator& operator=(const reverse_iterator<T>& oth) {
-                if (this != &oth) {
-                    _iter = oth._iter;
-                }
+                _iter = oth.base();
                 return (*this);
             }
             ~reverse_iterator() {
@@ -188,7 +191,7 @@ namespace ft {
 
             pointer operator->() const {
                 iterator_type temp = _iter;
-                return &(*--temp);
+                return _arrow(--temp);
             }
 
             reference operator[](difference_type n) {
@@ -247,34 +250,16 @@ namespace ft {
                 return *this;
             }
 
-            template<class T>
-            bool operator==(const reverse_iterator<T>& rhs) const {
-                return (_iter == rhs._iter);
-            }
-
-            template<class T>
-            bool operator!=(const reverse_iterator<T>& rhs) const {
-                return (_iter != rhs._iter);
-            }
-
-            template<class T>
-            bool operator>=(const reverse_iterator<T>& rhs) const {
-                return (_iter <= rhs._iter);
-            }
-
-            template<class T>
-            bool operator<=(const reverse_iterator<T>& rhs) const {
-                return (_iter >= rhs._iter);
-            }
-
-            template<class T>
-            bool operator>(const reverse_iterator<T>& rhs) const {
-                return (_iter < rhs._iter);
+        private:
+            /* Raw pointers are their own arrow, iterators may return a proxy */
+            template<class P>
+            static P* _arrow(P* ptr) {
+                return ptr;
             }
 
-            template<class T>
-            bool operator<(const reverse_iterator<T>& rhs) const {
-                return (_iter > rhs._iter);
+            template<class I>
+            static typename I::pointer _arrow(const I& iter) {
+                return iter.operator->();
             }
 
         private:
@@ -283,32 +268,32 @@ namespace ft {
 
     template< class Iterator1, class Iterator2 >
     bool operator==( const reverse_iterator<Iterator1>& lhs, const reverse_iterator<Iterator2>& rhs ) {
-        return (lhs == rhs);
+        return (lhs.base() == rhs.base());
     }
 
     template< class Iterator1, class Iterator2 >
     bool operator!=( const reverse_iterator<Iterator1>& lhs, const reverse_iterator<Iterator2>& rhs ) {
-        return (lhs != rhs);
+        return (lhs.base() != rhs.base());
     }
 
     template< class Iterator1, class Iterator2 >
     bool operator>=( const reverse_iterator<Iterator1>& lhs, const reverse_iterator<Iterator2>& rhs ) {
-        return (lhs >= rhs);
+        return (lhs.base() <= rhs.base());
     }
 
     template< class Iterator1, class Iterator2 >
     bool operator<=( const reverse_iterator<Iterator1>& lhs, const reverse_iterator<Iterator2>& rhs ) {
-        return (lhs <= rhs);
+        return (lhs.base() >= rhs.base());
     }
 
     template< class Iterator1, class Iterator2 >
     bool operator>( const reverse_iterator<Iterator1>& lhs, const reverse_iterator<Iterator2>& rhs ) {
-        return (lhs > rhs);
+        return (lhs.base() < rhs.base());
     }
 
     template< class Iterator1, class Iterator2 >
     bool operator<( const reverse_iterator<Iterator1>& lhs, const reverse_iterator<Iterator2>& rhs ) {
-        return (lhs < rhs);
+        return (lhs.base() > rhs.base());
     }
 
     template< class Iter >
@@ -4,6 +4,9 @@
 #include "pair.hpp"
 #include "algorithm.hpp"
 #include "treap.hpp"
+#include "compact_treap.hpp"
+#include "btree.hpp"
+#include "persistent_treap.hpp"
 
 #include <limits>
 #include <stdexcept>
@@ -11,7 +14,23 @@
 
 namespace ft {
 
-    template<class Key, class T, class Compare = std::less<Key>, class Alloc = std::allocator<pair<const Key, T> > >
+    /* Tree picks the node layout: ft::treap_tree (pointer links, the
+     * default), ft::order_statistic_tree (pointer links with subtree sizes,
+     * for the order statistics below), ft::threaded_tree (pointer links with
+     * in-order neighbour links, for O(1) iterator steps), ft::compact_tree
+     * (32-bit index links in a node array) or ft::btree_tree<NodeBytes> (a
+     * B-tree; modifications invalidate iterators). The pointer-linked trees
+     * are AVL balanced; ft::red_black_tree, ft::randomized_tree and
+     * ft::splay_tree balance them otherwise, ft::balanced_tree<Balance,
+     * Augment> combines a balancing policy with an augmentation. Splay trees
+     * restructure on non-const lookups. ft::aggregate_tree<Monoid> keeps a
+     * monoid aggregate per subtree, see ft::monoid_augment.
+     * ft::persistent_tree shares nodes between copies: copies are O(1)
+     * snapshots, and writes copy the O(log n) nodes on their path.
+     * ft::finger_tree starts every lookup from the node the previous one
+     * reached, see ft::finger_augment. */
+    template<class Key, class T, class Compare = std::less<Key>, class Alloc = std::allocator<pair<const Key, T> >,
+             class Tree = ft::treap_tree>
     class map {
     public:
         typedef Key key_type;
@@ -38,31 +57,89 @@ namespace ft {
             bool operator()(const value_type& lhs, const value_type& rhs) const {
                 return (_cmp(lhs.first, rhs.first));
             }
+
+            /* Key against value: lookups never build a value_type */
+            template<class K>
+            bool operator()(const K& lhs, const value_type& rhs) const {
+                return (_cmp(lhs, rhs.first));
+            }
+
+            template<class K>
+            bool operator()(const value_type& lhs, const K& rhs) const {
+                return (_cmp(lhs.first, rhs));
+            }
+        };
+
+        /* Enables the K overloads of lookups when key_compare is transparent */
+        template<class K, class R>
+        struct _if_transparent : ft::enable_if<ft::is_transparent<key_compare>::value, R> {
         };
 
     public:
         typedef pair_compare value_compare;
 
     private:
-        typedef Treap<value_type, value_compare, allocator_type> tree_type;
-        typedef typename tree_type::node_type node_type;
+        typedef typename Tree::template rebind<value_type, value_compare, allocator_type>::other tree_type;
+        typedef typename tree_type::slot_type slot_type;
 
     public:
         typedef typename tree_type::iterator iterator;
         typedef typename tree_type::const_iterator const_iterator;
         typedef typename tree_type::reverse_iterator reverse_iterator;
         typedef typename tree_type::const_reverse_iterator const_reverse_iterator;
+        typedef typename tree_type::aggregate_type aggregate_type;
+
+    private:
+        template<class Reference>
+        struct _mapped_reference {
+            typedef T& type;
+        };
+
+        template<class Value>
+        struct _mapped_reference<const Value&> {
+            typedef const T& type;
+        };
 
     public:
-        explicit map(const key_compare& comp = key_compare(), const allocator_type& alloc = allocator_type()) : _allocator(alloc), _treap(tree_type(comp, alloc)), _cmp(comp) {
+        /* T&, or const T& where iterators are read-only: on
+         * ft::aggregate_tree, mapped values change through insert_or_assign() */
+        typedef typename _mapped_reference<typename iterator::reference>::type mapped_reference;
+
+        /* Owning handle to an element taken out by extract(), see TreapNodeHandle */
+        class node_type : public tree_type::node_handle {
+        public:
+            typedef Key key_type;
+            typedef T mapped_type;
+
+            node_type() {
+            }
+
+            node_type(const typename tree_type::node_handle& other) : tree_type::node_handle(other) {
+            }
+
+            const key_type& key() const {
+                return this->value().first;
+            }
+
+            mapped_type& mapped() const {
+                return this->value().second;
+            }
+        };
+
+        struct insert_return_type {
+            iterator position;
+            bool inserted;
+            node_type node;
+        };
+
+    public:
+        explicit map(const key_compare& comp = key_compare(), const allocator_type& alloc = allocator_type()) : _allocator(alloc), _treap(comp, alloc), _cmp(comp) {
 
         }
 
         template< class InputIt >
-        map( InputIt first, InputIt last, const key_compare& comp = key_compare(), const allocator_type& alloc = allocator_type() ) : _allocator(alloc), _treap(tree_type(comp, alloc)), _cmp(comp) {
-            for (; first != last; ++first) {
-                _treap.insert(*first);
-            }
+        map( InputIt first, InputIt last, const key_compare& comp = key_compare(), const allocator_type& alloc = allocator_type() ) : _allocator(alloc), _treap(comp, alloc), _cmp(comp) {
+            _treap.assign(first, last);
         }
 
         map(const map& other) : _allocator(other._allocator), _treap(other._treap), _cmp(other._cmp){
@@ -71,7 +148,6 @@ namespace ft {
 
         map& operator=(const map& other) {
             if (this != &other) {
-                _allocator = other._allocator;
                 _cmp = other._cmp;
                 _treap = other._treap;
             }
@@ -88,8 +164,8 @@ namespace ft {
 
     /* Element access */
     public:
-        mapped_type& at(const key_type& key) {
-            iterator it = _treap.find(ft::make_pair(key, mapped_type()));
+        mapped_reference at(const key_type& key) {
+            iterator it = _treap.find(key);
             if (it == end()) {
                 throw std::out_of_range("No such element");
             } else {
@@ -98,7 +174,7 @@ namespace ft {
         }
 
         const mapped_type& at(const key_type& key) const {
-            iterator it = _treap.find(ft::make_pair(key, mapped_type()));
+            const_iterator it = _treap.find(key);
             if (it == end()) {
                 throw std::out_of_range("No such element");
             } else {
@@ -106,8 +182,8 @@ namespace ft {
             }
         }
 
-        mapped_type& operator[](const key_type& key) {
-            return (_treap.insert(ft::make_pair(key, mapped_type())).first)->second;
+        mapped_reference operator[](const key_type& key) {
+            return try_emplace(key).first->second;
         }
 
     /* Iterators */
@@ -174,32 +250,74 @@ namespace ft {
             return _treap.insert(hint, value);
         }
 
+        ft::pair<iterator, bool> try_emplace(const key_type& key) {
+            slot_type slot;
+            iterator it = _treap.locate(key, slot);
+            if (it != end()) {
+                return ft::make_pair(it, false);
+            } else {
+                return ft::make_pair(_treap.insert_at(slot, value_type(key, mapped_type())), true);
+            }
+        }
+
+        ft::pair<iterator, bool> try_emplace(const key_type& key, const mapped_type& obj) {
+            slot_type slot;
+            iterator it = _treap.locate(key, slot);
+            if (it != end()) {
+                return ft::make_pair(it, false);
+            } else {
+                return ft::make_pair(_treap.insert_at(slot, value_type(key, obj)), true);
+            }
+        }
+
+        ft::pair<iterator, bool> insert_or_assign(const key_type& key, const mapped_type& obj) {
+            slot_type slot;
+            iterator it = _treap.locate(key, slot);
+            if (it != end()) {
+                /* The node itself is not const, only the view of aggregate trees */
+                const_cast<mapped_type&>(it->second) = obj;
+                _treap.refresh(it);
+                return ft::make_pair(it, false);
+            } else {
+                return ft::make_pair(_treap.insert_at(slot, value_type(key, obj)), true);
+            }
+        }
+
         template< class InputIt >
         void insert( InputIt first, InputIt last ) {
-            for (; first != last; ) {
-                insert(*first);
-                ++first;
+            if (empty()) {
+                _treap.assign(first, last);
+                return;
+            }
+            iterator hint = end();
+            for (; first != last; ++first) {
+                hint = _treap.insert(hint, *first);
             }
         }
 
+        /* Bulk load: replaces the contents with [first, last) in O(n) for
+         * input sorted by key, O(n log n) otherwise */
+        template< class InputIt >
+        void assign( InputIt first, InputIt last ) {
+            _treap.assign(first, last);
+        }
+
         void erase(iterator pos) {
             _treap.erase(pos);
         }
 
         size_type erase(const key_type& key) {
-            iterator it = _treap.find(value_type(key, mapped_type()));
+            iterator it = _treap.find(key);
             if (it == end()) {
                 return 0;
             } else {
-                return _treap.erase(it);
+                _treap.erase(it);
+                return 1;
             }
         }
 
         void erase(iterator first, iterator last) {
-            for ( ; first != last; ) {
-                _treap.erase(first);
-                ++first;
-            }
+            _treap.erase(first, last);
         }
 
         void swap(map& other) {
@@ -208,48 +326,209 @@ namespace ft {
             ft::swap(_cmp, other._cmp);
         }
 
+    /* Splitting and joining, pointer-linked trees only. Nodes move between
+     * the maps as they are, iterators stay valid. */
+    public:
+        /* Moves the keys not less than key into upper, replacing its contents */
+        void split(const key_type& key, map& upper) {
+            _treap.split(key, upper._treap);
+        }
+
+        /* Moves [first, last) into out, replacing its contents */
+        void extract(iterator first, iterator last, map& out) {
+            _treap.extract(first, last, out._treap);
+        }
+
+        /* Takes every element of other, leaving it empty. O(log n) when the
+         * key ranges do not interleave; keys already present here win. */
+        void join(map& other) {
+            _treap.join(other._treap);
+        }
+
+    /* Node handles, pointer-linked trees only: elements move between maps
+     * without being copied or allocated */
+    public:
+        node_type extract(iterator pos) {
+            return _treap.extract(pos);
+        }
+
+        node_type extract(const key_type& key) {
+            return _treap.extract(key);
+        }
+
+        /* Takes the node of nh when its key is absent, otherwise it comes
+         * back in the result. Passing a handle hands its node over. */
+        insert_return_type insert(node_type nh) {
+            ft::pair<iterator, bool> result = _treap.insert(nh);
+            insert_return_type ret;
+            ret.position = result.first;
+            ret.inserted = result.second;
+            ret.node = nh;
+            return ret;
+        }
+
+        /* Moves the elements of other whose keys are absent here */
+        void merge(map& other) {
+            _treap.merge(other._treap);
+        }
+
     /* Lookup */
     public:
         size_type count(const key_type& key) const {
-            if (_treap.find(value_type(key, mapped_type())) != end()) {
-                return 1;
-            } else {
-                return 0;
-            }
+            return (_treap.find(key) != end() ? 1 : 0);
+        }
+
+        template<class K>
+        typename _if_transparent<K, size_type>::type count(const K& key) const {
+            return (_treap.find(key) != end() ? 1 : 0);
         }
 
         iterator find(const key_type& key) {
-            return _treap.find(value_type(key, mapped_type()));
+            return _treap.find(key);
         }
 
         const_iterator find(const key_type& key) const {
-            return _treap.find(value_type(key, mapped_type()));
+            return _treap.find(key);
+        }
+
+        template<class K>
+        typename _if_transparent<K, iterator>::type find(const K& key) {
+            return _treap.find(key);
+        }
+
+        template<class K>
+        typename _if_transparent<K, const_iterator>::type find(const K& key) const {
+            return _treap.find(key);
         }
 
         ft::pair<iterator, iterator> equal_range(const key_type& key) {
-            value_type value = value_type(key, mapped_type());
-            return ft::make_pair(_treap.lower_bound(value), _treap.upper_bound(value));
+            return ft::make_pair(_treap.lower_bound(key), _treap.upper_bound(key));
         }
 
         ft::pair<const_iterator, const_iterator> equal_range(const key_type& key) const {
-            value_type value = value_type(key, mapped_type());
-            return ft::make_pair(_treap.lower_bound(value), _treap.upper_bound(value));
+            return ft::make_pair(_treap.lower_bound(key), _treap.upper_bound(key));
+        }
+
+        template<class K>
+        typename _if_transparent<K, ft::pair<iterator, iterator> >::type equal_range(const K& key) {
+            return ft::make_pair(_treap.lower_bound(key), _treap.upper_bound(key));
+        }
+
+        template<class K>
+        typename _if_transparent<K, ft::pair<const_iterator, const_iterator> >::type equal_range(const K& key) const {
+            return ft::make_pair(_treap.lower_bound(key), _treap.upper_bound(key));
         }
 
         iterator lower_bound(const key_type& key) {
-            return _treap.lower_bound(value_type(key, mapped_type()));
+            return _treap.lower_bound(key);
         }
 
         const_iterator lower_bound(const key_type& key) const {
-            return _treap.lower_bound(value_type(key, mapped_type()));
+            return _treap.lower_bound(key);
+        }
+
+        template<class K>
+        typename _if_transparent<K, iterator>::type lower_bound(const K& key) {
+            return _treap.lower_bound(key);
+        }
+
+        template<class K>
+        typename _if_transparent<K, const_iterator>::type lower_bound(const K& key) const {
+            return _treap.lower_bound(key);
         }
 
         iterator upper_bound(const key_type& key) {
-            return _treap.upper_bound(value_type(key, mapped_type()));
+            return _treap.upper_bound(key);
         }
 
         const_iterator upper_bound(const key_type& key) const {
-            return _treap.upper_bound(value_type(key, mapped_type()));
+            return _treap.upper_bound(key);
+        }
+
+        template<class K>
+        typename _if_transparent<K, iterator>::type upper_bound(const K& key) {
+            return _treap.upper_bound(key);
+        }
+
+        template<class K>
+        typename _if_transparent<K, const_iterator>::type upper_bound(const K& key) const {
+            return _treap.upper_bound(key);
+        }
+
+    /* Batched lookups, pointer-linked trees only */
+    public:
+        /* Writes find(key) for every key of [first, last) to out, in order.
+         * The searches run side by side with their cache misses overlapped,
+         * much faster than a loop of find() once the map outgrows the cache.
+         * Splay trees are not restructured. Returns the end of the output. */
+        template<class ForwardIt, class OutputIt>
+        OutputIt find_many(ForwardIt first, ForwardIt last, OutputIt out) {
+            return _treap.find_many(first, last, out);
+        }
+
+        template<class ForwardIt, class OutputIt>
+        OutputIt find_many(ForwardIt first, ForwardIt last, OutputIt out) const {
+            return _treap.find_many(first, last, out);
+        }
+
+    /* Order statistics, O(log n), with ft::order_statistic_tree only */
+    public:
+        iterator nth(size_type k) {
+            return _treap.nth(k);
+        }
+
+        const_iterator nth(size_type k) const {
+            return _treap.nth(k);
+        }
+
+        /* Number of keys less than key */
+        size_type rank(const key_type& key) const {
+            return _treap.rank(key);
+        }
+
+        template<class K>
+        typename _if_transparent<K, size_type>::type rank(const K& key) const {
+            return _treap.rank(key);
+        }
+
+        /* Number of keys in [lo, hi) */
+        size_type count_range(const key_type& lo, const key_type& hi) const {
+            if (!_cmp(lo, hi)) {
+                return 0;
+            }
+            return _treap.rank(hi) - _treap.rank(lo);
+        }
+
+        difference_type distance(iterator first, iterator last) const {
+            return difference_type(_treap.index(last)) - difference_type(_treap.index(first));
+        }
+
+        difference_type distance(const_iterator first, const_iterator last) const {
+            return difference_type(_treap.index(last)) - difference_type(_treap.index(first));
+        }
+
+    /* Range aggregates, O(log n), with ft::aggregate_tree<Monoid> */
+    public:
+        /* Monoid aggregate of the elements with keys in [lo, hi), in key order */
+        aggregate_type aggregate(const key_type& lo, const key_type& hi) const {
+            return _treap.aggregate(lo, hi);
+        }
+
+        template<class K>
+        typename _if_transparent<K, aggregate_type>::type aggregate(const K& lo, const K& hi) const {
+            return _treap.aggregate(lo, hi);
+        }
+
+        /* Aggregate of every element, O(1) */
+        aggregate_type aggregate() const {
+            return _treap.aggregate();
+        }
+
+        /* Brings the aggregates up to date after what the mapped value at
+         * pos lifts to changed without a write to it, say through a pointer
+         * it holds, O(log n) */
+        void refresh(iterator pos) {
+            _treap.refresh(pos);
         }
 
     /* Observers */
@@ -269,44 +548,44 @@ namespace ft {
 
     };
 
-    template< class Key, class T, class Compare, class Alloc >
-    bool operator==(const ft::map<Key, T, Compare, Alloc>& lhs,
-                    const ft::map<Key, T, Compare, Alloc>& rhs ) {
+    template< class Key, class T, class Compare, class Alloc, class Tree >
+    bool operator==(const ft::map<Key, T, Compare, Alloc, Tree>& lhs,
+                    const ft::map<Key, T, Compare, Alloc, Tree>& rhs ) {
         return ft::equal(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
     }
 
-    template< class Key, class T, class Compare, class Alloc >
-    bool operator!=(const ft::map<Key, T, Compare, Alloc>& lhs,
-                    const ft::map<Key, T, Compare, Alloc>& rhs ) {
+    template< class Key, class T, class Compare, class Alloc, class Tree >
+    bool operator!=(const ft::map<Key, T, Compare, Alloc, Tree>& lhs,
+                    const ft::map<Key, T, Compare, Alloc, Tree>& rhs ) {
         return !(lhs == rhs);
     }
 
-    template< class Key, class T, class Compare, class Alloc >
-    bool operator<(const ft::map<Key, T, Compare, Alloc>& lhs,
-                    const ft::map<Key, T, Compare, Alloc>& rhs ) {
+    template< class Key, class T, class Compare, class Alloc, class Tree >
+    bool operator<(const ft::map<Key, T, Compare, Alloc, Tree>& lhs,
+                    const ft::map<Key, T, Compare, Alloc, Tree>& rhs ) {
         return ft::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
     }
 
-    template< class Key, class T, class Compare, class Alloc >
-    bool operator<=(const ft::map<Key, T, Compare, Alloc>& lhs,
-                    const ft::map<Key, T, Compare, Alloc>& rhs ) {
+    template< class Key, class T, class Compare, class Alloc, class Tree >
+    bool operator<=(const ft::map<Key, T, Compare, Alloc, Tree>& lhs,
+                    const ft::map<Key, T, Compare, Alloc, Tree>& rhs ) {
         return (lhs == rhs || lhs < rhs);
     }
 
-    template< class Key, class T, class Compare, class Alloc >
-    bool operator>(const ft::map<Key, T, Compare, Alloc>& lhs,
-                    const ft::map<Key, T, Compare, Alloc>& rhs ) {
+    template< class Key, class T, class Compare, class Alloc, class Tree >
+    bool operator>(const ft::map<Key, T, Compare, Alloc, Tree>& lhs,
+                    const ft::map<Key, T, Compare, Alloc, Tree>& rhs ) {
         return !(lhs <= rhs);
     }
 
-    template< class Key, class T, class Compare, class Alloc >
-    bool operator>=(const ft::map<Key, T, Compare, Alloc>& lhs,
-                    const ft::map<Key, T, Compare, Alloc>& rhs ) {
+    template< class Key, class T, class Compare, class Alloc, class Tree >
+    bool operator>=(const ft::map<Key, T, Compare, Alloc, Tree>& lhs,
+                    const ft::map<Key, T, Compare, Alloc, Tree>& rhs ) {
         return !(lhs < rhs);
     }
 
-    template< class Key, class T>
-    void swap(ft::map<Key, T>& lhs, ft::map<Key, T>& rhs) {
+    template< class Key, class T, class Compare, class Alloc, class Tree >
+    void swap(ft::map<Key, T, Compare, Alloc, Tree>& lhs, ft::map<Key, T, Compare, Alloc, Tree>& rhs) {
         lhs.swap(rhs);
     }
 
@@ -0,0 +1,249 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+
+#include "algorithm.hpp"
+#include "vector.hpp"
+
+namespace ft {
+
+    /* Node pool: hands out raw node storage carved from large slabs.
+     * Freed cells go to a free list and are reused first. Slabs are only
+     * returned to the allocator all at once, by release(). Nodes may move
+     * to other trees: slabs are reference counted, the pools of both trees
+     * and node handles hold them, and the last holder returns them. */
+    template<class Node, class Alloc = std::allocator<Node> >
+    class NodePool {
+    public:
+        typedef Node node_type;
+        typedef Alloc allocator_type;
+        typedef typename allocator_type::pointer pointer;
+        typedef typename allocator_type::size_type size_type;
+
+    private:
+        typedef typename allocator_type::template rebind<pointer>::other slab_allocator;
+
+        /* First cell of every slab */
+        struct _slab_header {
+            size_type cells;
+            size_type refs;
+        };
+
+        /* A freed cell, links the free list */
+        struct _free_cell {
+            _free_cell* next;
+        };
+
+        enum {
+            _min_slab = 32,
+            _max_slab = 16384
+        };
+
+    public:
+        explicit NodePool(const allocator_type& allocator = allocator_type())
+                : _allocator(allocator), _slabs(slab_allocator(allocator)), _free(nullptr), _next(nullptr), _end(nullptr), _capacity(0) {
+        }
+
+        ~NodePool() {
+            release();
+        }
+
+    private:
+        NodePool(const NodePool&);
+        NodePool& operator=(const NodePool&);
+
+    public:
+        /* Storage for one node, not constructed */
+        pointer allocate() {
+            if (_free) {
+                pointer cell = reinterpret_cast<pointer>(_free);
+                _free = _free->next;
+                return cell;
+            }
+            if (_next == _end) {
+                size_type cells = (_capacity < _max_slab ? _capacity : static_cast<size_type>(_max_slab));
+                _add_slab(cells > _min_slab ? cells : static_cast<size_type>(_min_slab));
+            }
+            return _next++;
+        }
+
+        /* Takes back storage of a node that is already destroyed */
+        void deallocate(pointer cell) {
+            _free_cell* free = reinterpret_cast<_free_cell*>(cell);
+            free->next = _free;
+            _free = free;
+        }
+
+        /* Makes the next count allocations come from one contiguous slab */
+        void reserve(size_type count) {
+            if (static_cast<size_type>(_end - _next) < count) {
+                for (; _next != _end; ++_next) {
+                    deallocate(_next);
+                }
+                _add_slab(count);
+            }
+        }
+
+        /* Returns every slab nobody else holds to the allocator. Nodes
+         * still living there are gone without their destructors being run. */
+        void release() {
+            for (size_type i = 0; i < _slabs.size(); ++i) {
+                release_slab(_allocator, _slabs[i]);
+            }
+            _slabs.clear();
+            _free = nullptr;
+            _next = _end = nullptr;
+            _capacity = 0;
+        }
+
+        size_type capacity() const {
+            return _capacity;
+        }
+
+        allocator_type get_allocator() const {
+            return _allocator;
+        }
+
+        /* Slab that cell was carved from, one of the slabs this pool holds */
+        pointer slab_of(pointer cell) const {
+            std::less<pointer> less;
+            size_type first = 0;
+            size_type count = _slabs.size();
+            while (count > 0) {
+                size_type half = count / 2;
+                if (!less(cell, _slabs[first + half])) {
+                    first += half + 1;
+                    count -= half + 1;
+                } else {
+                    count = half;
+                }
+            }
+            return _slabs[first - 1];
+        }
+
+        /* Holds every slab of other too, so that its nodes can be handed
+         * over to this pool's owner. Allocators must compare equal. */
+        void share(const NodePool& other) {
+            _merge(other._slabs, false);
+        }
+
+        /* Takes over the slabs of other, leaving it empty. Its free cells are
+         * kept when this pool has none of its own. Allocators must compare equal. */
+        void adopt(NodePool& other) {
+            if (this == &other) {
+                return;
+            }
+            _merge(other._slabs, true);
+            if (!_free) {
+                _free = other._free;
+            }
+            if (_next == _end) {
+                _next = other._next;
+                _end = other._end;
+            }
+            other._slabs.clear();
+            other._free = nullptr;
+            other._next = other._end = nullptr;
+            other._capacity = 0;
+        }
+
+        /* Holds slab, unless it already does */
+        void hold(pointer slab) {
+            size_type index = _lower_index(slab);
+            if (index == _slabs.size() || _slabs[index] != slab) {
+                retain_slab(slab);
+                _slabs.insert(_slabs.begin() + index, slab);
+                _capacity += reinterpret_cast<_slab_header*>(slab)->cells;
+            }
+        }
+
+        /* References to one slab held outside of pools */
+        static void retain_slab(pointer slab) {
+            ++reinterpret_cast<_slab_header*>(slab)->refs;
+        }
+
+        static void release_slab(allocator_type& allocator, pointer slab) {
+            _slab_header* header = reinterpret_cast<_slab_header*>(slab);
+            if (--header->refs == 0) {
+                allocator.deallocate(slab, header->cells + 1);
+            }
+        }
+
+        void swap(NodePool& other) {
+            ft::swap(_allocator, other._allocator);
+            _slabs.swap(other._slabs);
+            ft::swap(_free, other._free);
+            ft::swap(_next, other._next);
+            ft::swap(_end, other._end);
+            ft::swap(_capacity, other._capacity);
+        }
+
+    private:
+        void _add_slab(size_type cells) {
+            pointer slab = _allocator.allocate(cells + 1);
+            _slab_header* header = reinterpret_cast<_slab_header*>(slab);
+            header->cells = cells;
+            header->refs = 0;
+            hold(slab);
+            _next = slab + 1;
+            _end = _next + cells;
+        }
+
+        /* First held slab not below slab */
+        size_type _lower_index(pointer slab) const {
+            std::less<pointer> less;
+            size_type first = 0;
+            size_type count = _slabs.size();
+            while (count > 0) {
+                size_type half = count / 2;
+                if (less(_slabs[first + half], slab)) {
+                    first += half + 1;
+                    count -= half + 1;
+                } else {
+                    count = half;
+                }
+            }
+            return first;
+        }
+
+        /* Merges sorted slabs into the held ones. Their references are
+         * either taken over or new ones are added. */
+        template<class Slabs>
+        void _merge(const Slabs& slabs, bool take) {
+            std::less<pointer> less;
+            Slabs merged(_slabs.get_allocator());
+            merged.reserve(_slabs.size() + slabs.size());
+            size_type i = 0;
+            size_type j = 0;
+            while (i < _slabs.size() || j < slabs.size()) {
+                if (j == slabs.size() || (i < _slabs.size() && less(_slabs[i], slabs[j]))) {
+                    merged.push_back(_slabs[i++]);
+                } else if (i < _slabs.size() && _slabs[i] == slabs[j]) {
+                    if (take) {
+                        --reinterpret_cast<_slab_header*>(slabs[j])->refs;
+                    }
+                    merged.push_back(_slabs[i++]);
+                    ++j;
+                } else {
+                    if (!take) {
+                        retain_slab(slabs[j]);
+                    }
+                    _capacity += reinterpret_cast<_slab_header*>(slabs[j])->cells;
+                    merged.push_back(slabs[j++]);
+                }
+            }
+            _slabs.swap(merged);
+        }
+
+    private:
+        allocator_type _allocator;
+        ft::vector<pointer, slab_allocator> _slabs;
+        _free_cell* _free;
+        pointer _next;
+        pointer _end;
+        size_type _capacity;
+    };
+
+} //namespace ft
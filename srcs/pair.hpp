@@ -36,10 +36,6 @@ namespace ft {
             }
             return *this;
         }
-
-        ~pair() {
-
-        }
     };
 
     template<class F, class S>
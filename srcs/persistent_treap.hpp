@@ -0,0 +1,736 @@
+#pragma once
+
+#include <memory>
+
+#include "iterators.hpp"
+#include "iterators_traits.hpp"
+#include "algorithm.hpp"
+#include "pair.hpp"
+#include "vector.hpp"
+
+namespace ft {
+
+    /* Persistent treap node. A node is shared by every version of the tree
+     * that reaches it; refs counts the links and roots pointing at it. */
+    template<class U>
+    struct _persistent_node {
+        typedef U value_type;
+
+        value_type value;
+        _persistent_node* left;
+        _persistent_node* right;
+        size_t refs;
+        int height;
+
+        explicit _persistent_node(const value_type& value) : value(value), left(nullptr), right(nullptr), refs(1), height(1) {
+        }
+    };
+
+    /* Persistent treap iterator. Nodes have no parent links, as a shared
+     * node has a parent in every version, so the iterator keeps the path
+     * from the root. Mutable iterators own their path: nodes shared with
+     * another version are copied as the iterator reaches them, and writes
+     * through the iterator stay in its own version. */
+    template<class Tree, typename T>
+    class PersistentTreapIter : iterator<T, ft::bidirectional_iterator_tag> {
+    public:
+        typedef ft::bidirectional_iterator_tag iterator_category;
+        typedef typename ft::iterator_traits<T*>::value_type 		value_type;
+        typedef T*			                                        pointer;
+        typedef T& 		                                            reference;
+        typedef typename ft::iterator_traits<T*>::difference_type	difference_type;
+        typedef typename Tree::node_pointer node_pointer;
+
+        /* Deepest path: an AVL tree this high holds more than 10^13 nodes */
+        enum { max_depth = 64 };
+
+    public:
+        PersistentTreapIter() : _tree(nullptr), _depth(0) {
+        }
+
+        PersistentTreapIter(const Tree* tree, const node_pointer* path, size_t depth) : _tree(tree), _depth(depth) {
+            for (size_t i = 0; i < depth; ++i) {
+                _path[i] = path[i];
+            }
+            _settle(0);
+        }
+
+        PersistentTreapIter(const PersistentTreapIter& other) : _tree(other._tree), _depth(other._depth) {
+            for (size_t i = 0; i < _depth; ++i) {
+                _path[i] = other._path[i];
+            }
+        }
+
+        /* iterator to const_iterator */
+        template<class U>
+        PersistentTreapIter(const PersistentTreapIter<Tree, U>& other) : _tree(other.tree()), _depth(other.depth()) {
+            for (size_t i = 0; i < _depth; ++i) {
+                _path[i] = other.path()[i];
+            }
+        }
+
+        PersistentTreapIter& operator=(const PersistentTreapIter& other) {
+            _tree = other._tree;
+            _depth = other._depth;
+            for (size_t i = 0; i < _depth; ++i) {
+                _path[i] = other._path[i];
+            }
+            return *this;
+        }
+
+    public:
+        /* The node, nullptr for end() */
+        node_pointer base() const {
+            return (_depth ? _path[_depth - 1] : nullptr);
+        }
+
+        const Tree* tree() const {
+            return _tree;
+        }
+
+        const node_pointer* path() const {
+            return _path;
+        }
+
+        size_t depth() const {
+            return _depth;
+        }
+
+        reference operator*() const {
+            return _path[_depth - 1]->value;
+        }
+
+        pointer operator->() const {
+            return &(_path[_depth - 1]->value);
+        }
+
+        PersistentTreapIter& operator++() {
+            node_pointer pnode = _path[_depth - 1];
+            if (pnode->right) {
+                size_t from = _depth;
+                for (pnode = pnode->right; pnode; pnode = pnode->left) {
+                    _path[_depth++] = pnode;
+                }
+                _settle(from);
+            } else {
+                node_pointer child;
+                do {
+                    child = _path[--_depth];
+                } while (_depth > 0 && _path[_depth - 1]->right == child);
+            }
+            return *this;
+        }
+
+        PersistentTreapIter operator++(int) {
+            PersistentTreapIter temp(*this);
+            ++(*this);
+            return temp;
+        }
+
+        PersistentTreapIter& operator--() {
+            node_pointer pnode = (_depth ? _path[_depth - 1]->left : _tree->root());
+            if (pnode) {
+                size_t from = _depth;
+                for (; pnode; pnode = pnode->right) {
+                    _path[_depth++] = pnode;
+                }
+                _settle(from);
+            } else {
+                node_pointer child;
+                do {
+                    child = _path[--_depth];
+                } while (_depth > 0 && _path[_depth - 1]->left == child);
+            }
+            return *this;
+        }
+
+        PersistentTreapIter operator--(int) {
+            PersistentTreapIter temp(*this);
+            --(*this);
+            return temp;
+        }
+
+    private:
+        /* Copies the shared nodes of the path from depth from on */
+        void _settle(size_t from) {
+            _settle(from, static_cast<T*>(nullptr));
+        }
+
+        void _settle(size_t from, value_type*) {
+            if (from < _depth) {
+                const_cast<Tree*>(_tree)->unshare(_path, from, _depth);
+            }
+        }
+
+        void _settle(size_t, const value_type*) {
+        }
+
+    private:
+        const Tree* _tree;
+        size_t _depth;
+        node_pointer _path[max_depth];
+    };
+
+    template<class Tree, class U, class V>
+    bool operator==(const PersistentTreapIter<Tree, U>& lhs, const PersistentTreapIter<Tree, V>& rhs) {
+        return (lhs.base() == rhs.base());
+    }
+
+    template<class Tree, class U, class V>
+    bool operator!=(const PersistentTreapIter<Tree, U>& lhs, const PersistentTreapIter<Tree, V>& rhs) {
+        return (lhs.base() != rhs.base());
+    }
+
+    /* Persistent treap: the AVL tree of Treap with reference-counted nodes
+     * shared between copies. A copy takes the root, O(1). A write copies
+     * the nodes on its path that another version also reaches, O(log n)
+     * allocations, and rebalances the copies; nodes only this version
+     * reaches are changed in place. Every other version keeps its nodes,
+     * so a snapshot stays readable and iterable while the original is
+     * written, from another thread as well: reference counts are atomic.
+     *
+     * Mutable iterators, from non-const lookups and begin(), copy shared
+     * nodes as they reach them, see PersistentTreapIter. Any write, and
+     * taking a copy, invalidates the iterators of the version written. */
+    template<class Value, class Compare = std::less<Value>, class Alloc = std::allocator<Value> >
+    class PersistentTreap {
+    public:
+        typedef Value value_type;
+        typedef Alloc allocator_type;
+        typedef Compare compare_type;
+        typedef _persistent_node<Value> node_type;
+
+        typedef typename allocator_type::template rebind<node_type>::other node_allocator;
+
+        typedef typename node_allocator::difference_type difference_type;
+        typedef typename node_allocator::size_type size_type;
+        typedef typename node_allocator::pointer node_pointer;
+        typedef PersistentTreapIter<PersistentTreap, value_type> iterator;
+        typedef PersistentTreapIter<PersistentTreap, const value_type> const_iterator;
+        typedef ft::reverse_iterator<iterator> reverse_iterator;
+        typedef ft::reverse_iterator<const_iterator> const_reverse_iterator;
+
+        /* Nodes may belong to other versions, they cannot be handed out */
+        struct node_handle {
+        };
+
+        /* No augmentations, no aggregates */
+        typedef void aggregate_type;
+
+        void refresh(iterator) {
+        }
+
+        /* A missed lookup keeps no place: insert_at() descends again, copying
+         * the path as it goes */
+        struct slot_type {
+        };
+
+    public:
+        PersistentTreap(const compare_type& cmp, const allocator_type& allocator = allocator_type())
+                : _node_allocator(allocator), _cmp(cmp), _root(nullptr), _size(0) {
+        }
+
+        PersistentTreap(const PersistentTreap& other)
+                : _node_allocator(other._node_allocator), _cmp(other._cmp), _root(_retain(other._root)), _size(other._size) {
+        }
+
+        PersistentTreap& operator=(const PersistentTreap& other) {
+            node_pointer root = _retain(other._root);
+            _release(_root);
+            _root = root;
+            _size = other._size;
+            _cmp = other._cmp;
+            return *this;
+        }
+
+        ~PersistentTreap() {
+            _release(_root);
+        }
+
+    /* iterators */
+    public:
+        iterator begin() {
+            return _leftmost<iterator>();
+        }
+
+        const_iterator begin() const {
+            return _leftmost<const_iterator>();
+        }
+
+        iterator end() {
+            return iterator(this, nullptr, 0);
+        }
+
+        const_iterator end() const {
+            return const_iterator(this, nullptr, 0);
+        }
+
+        reverse_iterator rbegin() {
+            return reverse_iterator(end());
+        }
+
+        const_reverse_iterator rbegin() const {
+            return const_reverse_iterator(end());
+        }
+
+        reverse_iterator rend() {
+            return reverse_iterator(begin());
+        }
+
+        const_reverse_iterator rend() const {
+            return const_reverse_iterator(begin());
+        }
+
+    /* Capacity */
+    public:
+        size_type size() const {
+            return _size;
+        }
+
+    /* Modifiers */
+    public:
+        /* Lets go of the nodes; those other versions reach stay */
+        void clear() {
+            _release(_root);
+            _root = nullptr;
+            _size = 0;
+        }
+
+        ft::pair<iterator, bool> insert(const value_type& value) {
+            slot_type slot;
+            iterator it = locate(value, slot);
+            if (it != end()) {
+                return ft::make_pair(it, false);
+            } else {
+                return ft::make_pair(insert_at(slot, value), true);
+            }
+        }
+
+        /* Same contract as Treap::locate() */
+        template<class K>
+        iterator locate(const K& key, slot_type&) {
+            return find(key);
+        }
+
+        iterator insert_at(const slot_type&, const value_type& value) {
+            _root = _insert(_root, value);
+            ++_size;
+            return find(value);
+        }
+
+        /* Same contract as Treap::assign() */
+        template<class InputIt>
+        void assign(InputIt first, InputIt last) {
+            ft::vector<node_pointer> nodes;
+            bool sorted = true;
+            clear();
+            for (; first != last; ++first) {
+                nodes.push_back(_create(*first));
+                if (sorted && nodes.size() > 1) {
+                    sorted = _cmp(nodes[nodes.size() - 2]->value, nodes.back()->value);
+                }
+            }
+            size_type count = nodes.size();
+            if (!sorted) {
+                ft::stable_sort(nodes.begin(), nodes.end(), _node_compare(_cmp));
+                count = 1;
+                for (size_type i = 1; i < nodes.size(); ++i) {
+                    if (_cmp(nodes[count - 1]->value, nodes[i]->value)) {
+                        nodes[count++] = nodes[i];
+                    } else {
+                        _release(nodes[i]);
+                    }
+                }
+            }
+            _root = _build_balanced(nodes.data(), count);
+            _size = count;
+        }
+
+        /* The hint saves nothing: a write walks down from the root anyway */
+        iterator insert(iterator, const value_type& value) {
+            return insert(value).first;
+        }
+
+        void erase(iterator pos) {
+            if (pos != end()) {
+                _root = _erase(_root, *pos);
+                --_size;
+            }
+        }
+
+        /* Each erased value is copied first: it is the key to the next one,
+         * and erasing can move every node of the range */
+        void erase(iterator first, iterator last) {
+            if (first == begin() && last == end()) {
+                clear();
+                return;
+            }
+            size_type count = 0;
+            for (iterator it = first; it != last; ++it) {
+                ++count;
+            }
+            for (; count > 0; --count) {
+                value_type value(*first);
+                _root = _erase(_root, value);
+                --_size;
+                first = upper_bound(value);
+            }
+        }
+
+        void swap(PersistentTreap& other) {
+            ft::swap(_node_allocator, other._node_allocator);
+            ft::swap(_cmp, other._cmp);
+            ft::swap(_root, other._root);
+            ft::swap(_size, other._size);
+        }
+
+    /* Lookup */
+    public:
+        template<class K>
+        iterator find(const K& key) {
+            return _find<iterator>(key);
+        }
+
+        template<class K>
+        const_iterator find(const K& key) const {
+            return _find<const_iterator>(key);
+        }
+
+        template<class K>
+        iterator lower_bound(const K& key) {
+            return _lower_bound<iterator>(key);
+        }
+
+        template<class K>
+        const_iterator lower_bound(const K& key) const {
+            return _lower_bound<const_iterator>(key);
+        }
+
+        template<class K>
+        iterator upper_bound(const K& key) {
+            return _upper_bound<iterator>(key);
+        }
+
+        template<class K>
+        const_iterator upper_bound(const K& key) const {
+            return _upper_bound<const_iterator>(key);
+        }
+
+    /* Observers */
+    public:
+        compare_type value_comp() {
+            return _cmp;
+        }
+
+    /* Path copying for PersistentTreapIter */
+    public:
+        node_pointer root() const {
+            return _root;
+        }
+
+        /* Makes path[from, depth) nodes of this version only. path[from - 1]
+         * must be already. */
+        void unshare(node_pointer* path, size_t from, size_t depth) {
+            for (size_t i = from; i < depth; ++i) {
+                if (i == 0) {
+                    _root = _own(_root);
+                    path[i] = _root;
+                } else if (path[i - 1]->left == path[i]) {
+                    path[i] = _own_left(path[i - 1]);
+                } else {
+                    path[i] = _own_right(path[i - 1]);
+                }
+            }
+        }
+
+    /* private helpers */
+    private:
+        template<class It>
+        It _leftmost() const {
+            node_pointer path[iterator::max_depth];
+            size_t depth = 0;
+            for (node_pointer pnode = _root; pnode; pnode = pnode->left) {
+                path[depth++] = pnode;
+            }
+            return It(this, path, depth);
+        }
+
+        template<class It, class K>
+        It _find(const K& key) const {
+            node_pointer path[iterator::max_depth];
+            size_t depth = _lower_path(key, path);
+            if (depth && _cmp(key, path[depth - 1]->value)) {
+                depth = 0;
+            }
+            return It(this, path, depth);
+        }
+
+        template<class It, class K>
+        It _lower_bound(const K& key) const {
+            node_pointer path[iterator::max_depth];
+            size_t depth = _lower_path(key, path);
+            return It(this, path, depth);
+        }
+
+        template<class It, class K>
+        It _upper_bound(const K& key) const {
+            node_pointer path[iterator::max_depth];
+            size_t depth = 0;
+            size_t bound = 0;
+            for (node_pointer pnode = _root; pnode; ) {
+                path[depth++] = pnode;
+                if (_cmp(key, pnode->value)) {
+                    bound = depth;
+                    pnode = pnode->left;
+                } else {
+                    pnode = pnode->right;
+                }
+            }
+            return It(this, path, bound);
+        }
+
+        /* Fills path down to the first node not less than key, returns its
+         * length, 0 when there is none */
+        template<class K>
+        size_t _lower_path(const K& key, node_pointer* path) const {
+            size_t depth = 0;
+            size_t bound = 0;
+            for (node_pointer pnode = _root; pnode; ) {
+                path[depth++] = pnode;
+                if (_cmp(pnode->value, key)) {
+                    pnode = pnode->right;
+                } else {
+                    bound = depth;
+                    pnode = pnode->left;
+                }
+            }
+            return bound;
+        }
+
+        /* The recursive writes below take over the reference of the link
+         * they are given and return the reference to store back in it */
+
+        node_pointer _insert(node_pointer pnode, const value_type& value) {
+            if (!pnode) {
+                return _create(value);
+            }
+            pnode = _own(pnode);
+            if (_cmp(value, pnode->value)) {
+                pnode->left = _insert(pnode->left, value);
+            } else {
+                pnode->right = _insert(pnode->right, value);
+            }
+            return _balance(pnode);
+        }
+
+        /* key is in the tree */
+        template<class K>
+        node_pointer _erase(node_pointer pnode, const K& key) {
+            if (_cmp(key, pnode->value)) {
+                pnode = _own(pnode);
+                pnode->left = _erase(pnode->left, key);
+                return _balance(pnode);
+            }
+            if (_cmp(pnode->value, key)) {
+                pnode = _own(pnode);
+                pnode->right = _erase(pnode->right, key);
+                return _balance(pnode);
+            }
+            return _remove(pnode);
+        }
+
+        /* A node with two children gives way to a new node holding its
+         * successor's value: the successor may be shared, so it cannot move */
+        node_pointer _remove(node_pointer pnode) {
+            if (!pnode->left || !pnode->right) {
+                node_pointer child = (pnode->left ? _detach_left(pnode) : _detach_right(pnode));
+                _release(pnode);
+                return child;
+            }
+            node_pointer successor = pnode->right;
+            while (successor->left) {
+                successor = successor->left;
+            }
+            node_pointer replacement = _create(successor->value);
+            replacement->left = _detach_left(pnode);
+            replacement->right = _erase_min(_detach_right(pnode));
+            _release(pnode);
+            return _balance(replacement);
+        }
+
+        node_pointer _erase_min(node_pointer pnode) {
+            if (!pnode->left) {
+                node_pointer right = _detach_right(pnode);
+                _release(pnode);
+                return right;
+            }
+            pnode = _own(pnode);
+            pnode->left = _erase_min(pnode->left);
+            return _balance(pnode);
+        }
+
+        /* A child link of a node about to be released: moved out when the
+         * node is this version's only, shared otherwise */
+        node_pointer _detach_left(node_pointer pnode) {
+            node_pointer child = pnode->left;
+            if (_unique(pnode)) {
+                pnode->left = nullptr;
+            } else {
+                _retain(child);
+            }
+            return child;
+        }
+
+        node_pointer _detach_right(node_pointer pnode) {
+            node_pointer child = pnode->right;
+            if (_unique(pnode)) {
+                pnode->right = nullptr;
+            } else {
+                _retain(child);
+            }
+            return child;
+        }
+
+        node_pointer _own_left(node_pointer pnode) {
+            pnode->left = _own(pnode->left);
+            return pnode->left;
+        }
+
+        node_pointer _own_right(node_pointer pnode) {
+            pnode->right = _own(pnode->right);
+            return pnode->right;
+        }
+
+        /* pnode itself when no other version reaches it, otherwise a copy
+         * sharing its children */
+        node_pointer _own(node_pointer pnode) {
+            if (_unique(pnode)) {
+                return pnode;
+            }
+            node_pointer copy = _create(pnode->value);
+            copy->left = _retain(pnode->left);
+            copy->right = _retain(pnode->right);
+            copy->height = pnode->height;
+            _release(pnode);
+            return copy;
+        }
+
+        bool _unique(node_pointer pnode) const {
+            return (__atomic_load_n(&pnode->refs, __ATOMIC_ACQUIRE) == 1);
+        }
+
+        static node_pointer _retain(node_pointer pnode) {
+            if (pnode) {
+                __atomic_add_fetch(&pnode->refs, 1, __ATOMIC_RELAXED);
+            }
+            return pnode;
+        }
+
+        /* Drops one reference, and the node with its children's references
+         * when it was the last */
+        void _release(node_pointer pnode) {
+            if (pnode && __atomic_sub_fetch(&pnode->refs, 1, __ATOMIC_ACQ_REL) == 0) {
+                _release(pnode->left);
+                _release(pnode->right);
+                _node_allocator.destroy(pnode);
+                _node_allocator.deallocate(pnode, 1);
+            }
+        }
+
+        node_pointer _create(const value_type& value) {
+            node_pointer pnode = _node_allocator.allocate(1);
+            _node_allocator.construct(pnode, node_type(value));
+            return pnode;
+        }
+
+        int _height(node_pointer pnode) const {
+            return (pnode ? pnode->height : 0);
+        }
+
+        int _bfactor(node_pointer pnode) const {
+            return _height(pnode->right) - _height(pnode->left);
+        }
+
+        void _fix_height(node_pointer pnode) {
+            int left = _height(pnode->left);
+            int right = _height(pnode->right);
+            pnode->height = (left > right ? left : right) + 1;
+        }
+
+        /* Rotations and _balance() take nodes of this version only */
+        node_pointer _rotate_right(node_pointer p) {
+            node_pointer q = _own_left(p);
+            p->left = q->right;
+            q->right = p;
+            _fix_height(p);
+            _fix_height(q);
+            return q;
+        }
+
+        node_pointer _rotate_left(node_pointer q) {
+            node_pointer p = _own_right(q);
+            q->right = p->left;
+            p->left = q;
+            _fix_height(q);
+            _fix_height(p);
+            return p;
+        }
+
+        node_pointer _balance(node_pointer pnode) {
+            _fix_height(pnode);
+            if (_bfactor(pnode) == 2) {
+                if (_bfactor(pnode->right) < 0) {
+                    pnode->right = _rotate_right(_own_right(pnode));
+                }
+                return _rotate_left(pnode);
+            }
+            if (_bfactor(pnode) == -2) {
+                if (_bfactor(pnode->left) > 0) {
+                    pnode->left = _rotate_left(_own_left(pnode));
+                }
+                return _rotate_right(pnode);
+            }
+            return pnode;
+        }
+
+        node_pointer _build_balanced(node_pointer* nodes, size_type count) {
+            if (count == 0) {
+                return nullptr;
+            }
+            size_type middle = count / 2;
+            node_pointer pnode = nodes[middle];
+            pnode->left = _build_balanced(nodes, middle);
+            pnode->right = _build_balanced(nodes + middle + 1, count - middle - 1);
+            _fix_height(pnode);
+            return pnode;
+        }
+
+    private:
+        struct _node_compare {
+            compare_type cmp;
+
+            _node_compare(const compare_type& cmp) : cmp(cmp) {
+            }
+
+            bool operator()(node_pointer lhs, node_pointer rhs) const {
+                return cmp(lhs->value, rhs->value);
+            }
+        };
+
+    private:
+        node_allocator _node_allocator;
+        compare_type _cmp;
+        node_pointer _root;
+        size_type _size;
+    };
+
+    /* Tree policy for ft::map: persistent nodes, O(1) copies that share
+     * structure, path copying on writes */
+    struct persistent_tree {
+        template<class Value, class Compare, class Alloc>
+        struct rebind {
+            typedef PersistentTreap<Value, Compare, Alloc> other;
+        };
+    };
+
+} //namespace ft
@@ -0,0 +1,186 @@
+#pragma once
+
+#include "map.hpp"
+#include "epoch.hpp"
+
+namespace ft {
+
+    /* A map read by any number of threads without locks while one thread
+     * writes. Every published version is an ft::map on ft::persistent_tree:
+     * the writer edits its own version, whose writes copy the nodes the
+     * published version shares (rotations included, the rotated nodes are
+     * copied too), then publishes it with a release store of a new root.
+     * Readers load the root with acquire in an epoch guard and walk nodes
+     * nobody changes any more; a replaced version is reclaimed through
+     * EpochDomain once the readers that could hold it are gone.
+     *
+     * One thread writes at a time: serialize writers outside. Each reader
+     * thread uses its own rcu_map::reader. */
+    template<class Key, class T, class Compare = std::less<Key>, class Alloc = std::allocator<pair<const Key, T> > >
+    class rcu_map {
+    public:
+        typedef ft::map<Key, T, Compare, Alloc, ft::persistent_tree> map_type;
+        typedef typename map_type::key_type key_type;
+        typedef typename map_type::mapped_type mapped_type;
+        typedef typename map_type::value_type value_type;
+        typedef typename map_type::key_compare key_compare;
+        typedef typename map_type::allocator_type allocator_type;
+        typedef typename map_type::size_type size_type;
+
+    private:
+        typedef typename allocator_type::template rebind<map_type>::other version_allocator;
+
+    public:
+        class read_guard;
+
+        /* A reader thread's slot in the epoch domain */
+        class reader {
+        public:
+            explicit reader(rcu_map& map) : _map(map), _self(map._domain) {
+            }
+
+            /* Copies the element mapped to key into value, if any */
+            bool find(const key_type& key, mapped_type& value) {
+                EpochDomain::guard guard(_self);
+                const map_type& version = *_map._acquire();
+                typename map_type::const_iterator it = version.find(key);
+                if (it == version.end()) {
+                    return (false);
+                }
+                value = it->second;
+                return (true);
+            }
+
+            size_type count(const key_type& key) {
+                EpochDomain::guard guard(_self);
+                return (_map._acquire()->count(key));
+            }
+
+            size_type size() {
+                EpochDomain::guard guard(_self);
+                return (_map._acquire()->size());
+            }
+
+        private:
+            reader(const reader&);
+            reader& operator=(const reader&);
+
+        private:
+            friend class read_guard;
+
+            rcu_map& _map;
+            EpochDomain::participant _self;
+        };
+
+        /* Pins the current version for several lookups or an iteration:
+         * the version and its iterators stay valid while the guard lives */
+        class read_guard {
+        public:
+            explicit read_guard(reader& self) : _guard(self._self), _version(self._map._acquire()) {
+            }
+
+            const map_type& operator*() const {
+                return (*_version);
+            }
+
+            const map_type* operator->() const {
+                return (_version);
+            }
+
+        private:
+            read_guard(const read_guard&);
+            read_guard& operator=(const read_guard&);
+
+        private:
+            EpochDomain::guard _guard;
+            const map_type* _version;
+        };
+
+    public:
+        explicit rcu_map(const key_compare& comp = key_compare(), const allocator_type& alloc = allocator_type())
+                : _version_allocator(alloc), _live(comp, alloc), _published(_new_version()), _writer(_domain) {
+        }
+
+        /* No reader may be left */
+        ~rcu_map() {
+            _writer.collect();
+            _delete_version(_published, this);
+        }
+
+    /* writer */
+    public:
+        /* The writer's version, not seen by readers until publish() */
+        map_type& edit() {
+            return (_live);
+        }
+
+        /* Makes the edits so far visible to readers that start after it */
+        void publish() {
+            map_type* previous = _published;
+            __atomic_store_n(&_published, _new_version(), __ATOMIC_SEQ_CST);
+            _writer.retire(previous, &_delete_version, this);
+        }
+
+        bool insert(const value_type& value) {
+            bool inserted = _live.insert(value).second;
+            if (inserted) {
+                publish();
+            }
+            return (inserted);
+        }
+
+        bool insert_or_assign(const key_type& key, const mapped_type& obj) {
+            bool inserted = _live.insert_or_assign(key, obj).second;
+            publish();
+            return (inserted);
+        }
+
+        size_type erase(const key_type& key) {
+            size_type erased = _live.erase(key);
+            if (erased) {
+                publish();
+            }
+            return (erased);
+        }
+
+        void clear() {
+            _live.clear();
+            publish();
+        }
+
+        /* Destroys the versions no reader can reach any more */
+        void collect() {
+            _writer.collect();
+        }
+
+    private:
+        rcu_map(const rcu_map&);
+        rcu_map& operator=(const rcu_map&);
+
+        const map_type* _acquire() const {
+            return (__atomic_load_n(&_published, __ATOMIC_ACQUIRE));
+        }
+
+        /* O(1): the copy shares the writer's nodes */
+        map_type* _new_version() {
+            map_type* version = _version_allocator.allocate(1);
+            _version_allocator.construct(version, _live);
+            return (version);
+        }
+
+        static void _delete_version(void* version, void* context) {
+            rcu_map* self = static_cast<rcu_map*>(context);
+            map_type* target = static_cast<map_type*>(version);
+            self->_version_allocator.destroy(target);
+            self->_version_allocator.deallocate(target, 1);
+        }
+
+    private:
+        version_allocator _version_allocator;
+        map_type _live;
+        map_type* _published;
+        EpochDomain _domain;
+        EpochDomain::participant _writer;
+    };
+
+} //namespace ft
@@ -0,0 +1,426 @@
+#pragma once
+
+#include <cerrno>
+#include <cstddef>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <stdint.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "iterators_traits.hpp"
+#include "algorithm.hpp"
+#include "pair.hpp"
+#include "vector.hpp"
+#include "map.hpp"
+#include "frozen_map.hpp"
+
+namespace ft {
+
+    /* Snapshot file: this header, then the element or key array and the
+     * mapped array, each on a 64-byte boundary so that a mapping of the file
+     * can be read in place. Elements are stored as their bytes, so only
+     * trivially copyable types qualify, and a file is only read back where
+     * the element sizes and the byte order match those recorded here. */
+    struct snapshot_header {
+        char magic[8];
+        uint32_t version;
+        uint32_t layout;
+        uint32_t order;
+        uint32_t key_size;
+        uint32_t mapped_size;
+        uint32_t reserved;
+        uint64_t count;
+        uint64_t keys;
+        uint64_t values;
+    };
+
+    /* What the arrays hold: the elements of a vector, the keys and values
+     * of a map in key order, or the Eytzinger arrays of a frozen_map, index
+     * 0 included */
+    enum snapshot_layout {
+        snapshot_array = 1,
+        snapshot_sorted = 2,
+        snapshot_eytzinger = 3
+    };
+
+    /* Read-only mapping of a snapshot file. Opening checks the header and
+     * reads nothing else: pages come in on first touch, so start-up costs
+     * the page faults of what is actually read. The arrays live as long as
+     * the snapshot. */
+    class snapshot {
+    public:
+        enum { version = 1, alignment = 64, order = 0x01020304 };
+
+        explicit snapshot(const char* path) : _data(nullptr), _length(0) {
+            int fd = ::open(path, O_RDONLY);
+            if (fd < 0) {
+                _fail("cannot open", path);
+            }
+            struct stat info;
+            if (::fstat(fd, &info) != 0) {
+                ::close(fd);
+                _fail("cannot stat", path);
+            }
+            _length = info.st_size;
+            if (_length < sizeof(snapshot_header)) {
+                ::close(fd);
+                throw std::runtime_error(std::string("ft::snapshot: truncated file ") + path);
+            }
+            void* data = ::mmap(nullptr, _length, PROT_READ, MAP_PRIVATE, fd, 0);
+            ::close(fd);
+            if (data == MAP_FAILED) {
+                _fail("cannot map", path);
+            }
+            _data = static_cast<const char*>(data);
+            if (!_valid()) {
+                ::munmap(data, _length);
+                throw std::runtime_error(std::string("ft::snapshot: not a snapshot of this version ") + path);
+            }
+        }
+
+        ~snapshot() {
+            ::munmap(const_cast<char*>(_data), _length);
+        }
+
+    public:
+        const snapshot_header& header() const {
+            return *reinterpret_cast<const snapshot_header*>(_data);
+        }
+
+        uint32_t layout() const {
+            return header().layout;
+        }
+
+        size_t size() const {
+            return header().count;
+        }
+
+        /* The element or key array, and the mapped array */
+        template<class T>
+        const T* keys() const {
+            return reinterpret_cast<const T*>(_data + header().keys);
+        }
+
+        template<class T>
+        const T* values() const {
+            return reinterpret_cast<const T*>(_data + header().values);
+        }
+
+        /* Throws unless the file holds one of layouts (a bit mask of 1 <<
+         * layout) with elements of these sizes */
+        void require(unsigned layouts, size_t key_size, size_t mapped_size) const {
+            const snapshot_header& head = header();
+            if (!(layouts & (1u << head.layout)) || head.key_size != key_size || head.mapped_size != mapped_size) {
+                throw std::runtime_error("ft::snapshot: layout or element size mismatch");
+            }
+        }
+
+        /* Hints that the whole file is about to be read front to back, so
+         * the kernel reads ahead instead of faulting page by page */
+        void sequential() const {
+            ::madvise(const_cast<char*>(_data), _length, MADV_SEQUENTIAL);
+            ::madvise(const_cast<char*>(_data), _length, MADV_WILLNEED);
+        }
+
+        /* Offset of the array that follows count elements of size at offset */
+        static uint64_t next_offset(uint64_t offset, uint64_t count, uint64_t size) {
+            return ((offset + count * size + alignment - 1) / alignment * alignment);
+        }
+
+        static void fill_header(snapshot_header& head, uint32_t layout, uint64_t count, size_t key_size, size_t mapped_size) {
+            std::memset(&head, 0, sizeof(head));
+            std::memcpy(head.magic, "ftsnap\n", 8);
+            head.version = version;
+            head.layout = layout;
+            head.order = order;
+            head.key_size = key_size;
+            head.mapped_size = mapped_size;
+            head.count = count;
+            head.keys = next_offset(0, 1, sizeof(snapshot_header));
+            head.values = next_offset(head.keys, count, key_size);
+        }
+
+    private:
+        snapshot(const snapshot&);
+        snapshot& operator=(const snapshot&);
+
+        static void _fail(const char* what, const char* path) {
+            throw std::runtime_error(std::string("ft::snapshot: ") + what + " " + path + ": " + std::strerror(errno));
+        }
+
+        /* Header of this version, and arrays that fit in the file */
+        bool _valid() const {
+            const snapshot_header& head = header();
+            snapshot_header expected;
+            fill_header(expected, head.layout, head.count, head.key_size, head.mapped_size);
+            if (std::memcmp(head.magic, expected.magic, sizeof(head.magic)) != 0 || head.version != version
+                    || head.order != order || head.keys != expected.keys || head.values != expected.values) {
+                return false;
+            }
+            if (head.layout < snapshot_array || head.layout > snapshot_eytzinger
+                    || (head.layout == snapshot_eytzinger && head.count == 0)) {
+                return false;
+            }
+            if (head.key_size == 0 || head.keys > _length || head.count > (_length - head.keys) / head.key_size) {
+                return false;
+            }
+            return (head.mapped_size == 0 || (head.values <= _length
+                    && head.count <= (_length - head.values) / head.mapped_size));
+        }
+
+    private:
+        const char* _data;
+        size_t _length;
+    };
+
+    /* Writes a snapshot next to its destination and renames it into place
+     * once it is on disk, so a reader never sees a partial file */
+    class SnapshotWriter {
+    public:
+        SnapshotWriter(const char* path, uint32_t layout, uint64_t count, size_t key_size, size_t mapped_size)
+                : _path(path), _temp(std::string(path) + ".tmp"), _fd(-1), _offset(0), _used(0) {
+            snapshot::fill_header(_header, layout, count, key_size, mapped_size);
+            _fd = ::open(_temp.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+            if (_fd < 0) {
+                _fail("cannot create");
+            }
+            put(&_header, sizeof(_header));
+        }
+
+        ~SnapshotWriter() {
+            if (_fd >= 0) {
+                ::close(_fd);
+                ::unlink(_temp.c_str());
+            }
+        }
+
+    public:
+        /* Starts the key or the mapped array */
+        void keys() {
+            _pad(_header.keys);
+        }
+
+        void values() {
+            _pad(_header.values);
+        }
+
+        /* Buffers small writes, large arrays go straight to the file */
+        void put(const void* data, size_t length) {
+            const char* bytes = static_cast<const char*>(data);
+            if (length >= _buffer_size) {
+                _flush();
+                _write(bytes, length);
+                _offset += length;
+                return;
+            }
+            while (length > 0) {
+                size_t chunk = (length < _buffer_size - _used ? length : _buffer_size - _used);
+                std::memcpy(_buffer + _used, bytes, chunk);
+                _used += chunk;
+                _offset += chunk;
+                bytes += chunk;
+                length -= chunk;
+                if (_used == _buffer_size) {
+                    _flush();
+                }
+            }
+        }
+
+        void commit() {
+            _pad(snapshot::next_offset(_offset, 0, 0));
+            _flush();
+            if (::fsync(_fd) != 0) {
+                _fail("cannot sync");
+            }
+            int fd = _fd;
+            _fd = -1;
+            if (::close(fd) != 0 || ::rename(_temp.c_str(), _path.c_str()) != 0) {
+                ::unlink(_temp.c_str());
+                _fail("cannot write");
+            }
+        }
+
+    private:
+        enum { _buffer_size = 1 << 16 };
+
+        SnapshotWriter(const SnapshotWriter&);
+        SnapshotWriter& operator=(const SnapshotWriter&);
+
+        void _pad(uint64_t offset) {
+            static const char zeros[snapshot::alignment] = { 0 };
+            put(zeros, offset - _offset);
+        }
+
+        void _flush() {
+            _write(_buffer, _used);
+            _used = 0;
+        }
+
+        void _write(const char* bytes, size_t length) {
+            while (length > 0) {
+                ssize_t written = ::write(_fd, bytes, length);
+                if (written < 0 && errno == EINTR) {
+                    continue;
+                }
+                if (written < 0) {
+                    _fail("cannot write");
+                }
+                bytes += written;
+                length -= written;
+            }
+        }
+
+        void _fail(const char* what) {
+            throw std::runtime_error(std::string("ft::snapshot: ") + what + " " + _temp + ": " + std::strerror(errno));
+        }
+
+    private:
+        std::string _path;
+        std::string _temp;
+        int _fd;
+        uint64_t _offset;
+        size_t _used;
+        snapshot_header _header;
+        char _buffer[_buffer_size];
+    };
+
+    /* Walks the sorted key and mapped arrays of a snapshot as map entries */
+    template<class Key, class T>
+    class SnapshotIter {
+    public:
+        typedef ft::forward_iterator_tag iterator_category;
+        typedef ft::pair<const Key, T> value_type;
+        typedef value_type reference;
+        typedef const value_type* pointer;
+        typedef std::ptrdiff_t difference_type;
+
+    public:
+        SnapshotIter(const Key* key, const T* value) : _key(key), _value(value) {
+        }
+
+        reference operator*() const {
+            return value_type(*_key, *_value);
+        }
+
+        SnapshotIter& operator++() {
+            ++_key;
+            ++_value;
+            return *this;
+        }
+
+        bool operator==(const SnapshotIter& other) const {
+            return (_key == other._key);
+        }
+
+        bool operator!=(const SnapshotIter& other) const {
+            return (_key != other._key);
+        }
+
+    private:
+        const Key* _key;
+        const T* _value;
+    };
+
+    /* save(): writes a container of trivially copyable elements to path,
+     * replacing the file. A vector is stored as its array, a map as its keys
+     * and values in key order, a frozen_map as its Eytzinger arrays. */
+    template<class T, class A>
+    typename ft::enable_if<ft::is_trivially_copyable<T>::value>::type
+    save(const char* path, const ft::vector<T, A>& data) {
+        SnapshotWriter out(path, snapshot_array, data.size(), sizeof(T), 0);
+        out.keys();
+        out.put(data.data(), data.size() * sizeof(T));
+        out.commit();
+    }
+
+    template<class Key, class T, class Compare, class Alloc, class Tree>
+    typename ft::enable_if<ft::is_trivially_copyable<Key>::value && ft::is_trivially_copyable<T>::value>::type
+    save(const char* path, const ft::map<Key, T, Compare, Alloc, Tree>& data) {
+        typedef typename ft::map<Key, T, Compare, Alloc, Tree>::const_iterator const_iterator;
+        SnapshotWriter out(path, snapshot_sorted, data.size(), sizeof(Key), sizeof(T));
+        out.keys();
+        for (const_iterator it = data.begin(); it != data.end(); ++it) {
+            out.put(&it->first, sizeof(Key));
+        }
+        out.values();
+        for (const_iterator it = data.begin(); it != data.end(); ++it) {
+            out.put(&it->second, sizeof(T));
+        }
+        out.commit();
+    }
+
+    template<class Key, class T, class Compare, class Alloc>
+    typename ft::enable_if<ft::is_trivially_copyable<Key>::value && ft::is_trivially_copyable<T>::value>::type
+    save(const char* path, const ft::frozen_map<Key, T, Compare, Alloc>& data) {
+        SnapshotWriter out(path, snapshot_eytzinger, data.size() + 1, sizeof(Key), sizeof(T));
+        out.keys();
+        out.put(data.keys(), (data.size() + 1) * sizeof(Key));
+        out.values();
+        out.put(data.values(), (data.size() + 1) * sizeof(T));
+        out.commit();
+    }
+
+    /* load(): replaces the contents with those saved at path, in one
+     * sequential pass over the mapped file. A map is linked from the sorted
+     * arrays in O(n); a map or a frozen_map can be loaded from either map
+     * layout. Throws std::runtime_error on a missing or mismatched file. */
+    template<class T, class A>
+    typename ft::enable_if<ft::is_trivially_copyable<T>::value>::type
+    load(const char* path, ft::vector<T, A>& data) {
+        snapshot file(path);
+        file.require(1u << snapshot_array, sizeof(T), 0);
+        file.sequential();
+        data.assign(file.keys<T>(), file.keys<T>() + file.size());
+    }
+
+    template<class Key, class T, class Compare, class Alloc, class Tree>
+    typename ft::enable_if<ft::is_trivially_copyable<Key>::value && ft::is_trivially_copyable<T>::value>::type
+    load(const char* path, ft::map<Key, T, Compare, Alloc, Tree>& data) {
+        snapshot file(path);
+        file.require(1u << snapshot_sorted | 1u << snapshot_eytzinger, sizeof(Key), sizeof(T));
+        file.sequential();
+        if (file.layout() == snapshot_sorted) {
+            data.assign(SnapshotIter<Key, T>(file.keys<Key>(), file.values<T>()),
+                        SnapshotIter<Key, T>(file.keys<Key>() + file.size(), file.values<T>() + file.size()));
+        } else {
+            ft::frozen_map<Key, T, Compare> view(file.keys<Key>(), file.values<T>(), file.size() - 1, data.key_comp());
+            data.assign(view.begin(), view.end());
+        }
+    }
+
+    template<class Key, class T, class Compare, class Alloc>
+    typename ft::enable_if<ft::is_trivially_copyable<Key>::value && ft::is_trivially_copyable<T>::value>::type
+    load(const char* path, ft::frozen_map<Key, T, Compare, Alloc>& data) {
+        typedef ft::frozen_map<Key, T, Compare, Alloc> frozen_type;
+        snapshot file(path);
+        file.require(1u << snapshot_sorted | 1u << snapshot_eytzinger, sizeof(Key), sizeof(T));
+        file.sequential();
+        if (file.layout() == snapshot_sorted) {
+            frozen_type loaded(SnapshotIter<Key, T>(file.keys<Key>(), file.values<T>()),
+                               SnapshotIter<Key, T>(file.keys<Key>() + file.size(), file.values<T>() + file.size()),
+                               data.key_comp(), data.get_allocator());
+            data.swap(loaded);
+        } else {
+            frozen_type mapped(file.keys<Key>(), file.values<T>(), file.size() - 1, data.key_comp());
+            frozen_type loaded(mapped.begin(), mapped.end(), data.key_comp(), data.get_allocator());
+            data.swap(loaded);
+        }
+    }
+
+    /* view(): points data at the arrays of an open frozen_map snapshot,
+     * nothing copied, so a lookup faults in only the pages on its search
+     * path. Valid while the snapshot is open. */
+    template<class Key, class T, class Compare, class Alloc>
+    typename ft::enable_if<ft::is_trivially_copyable<Key>::value && ft::is_trivially_copyable<T>::value>::type
+    view(const snapshot& file, ft::frozen_map<Key, T, Compare, Alloc>& data) {
+        file.require(1u << snapshot_eytzinger, sizeof(Key), sizeof(T));
+        ft::frozen_map<Key, T, Compare, Alloc> mapped(file.keys<Key>(), file.values<T>(), file.size() - 1,
+                                                      data.key_comp(), data.get_allocator());
+        data.swap(mapped);
+    }
+
+} //namespace ft
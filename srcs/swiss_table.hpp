@@ -0,0 +1,721 @@
+#pragma once
+
+#include <cstddef>
+#include <cstring>
+#include <memory>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#include "iterators_traits.hpp"
+#include "algorithm.hpp"
+#include "pair.hpp"
+
+namespace ft {
+
+    /* Control byte of a slot: the 7 low bits of its hash when the slot is
+     * full, otherwise a marker. Markers are negative, full slots are not. */
+    typedef signed char swiss_ctrl;
+
+    enum SwissMarker {
+        swiss_empty = -128,
+        swiss_deleted = -2,
+        swiss_sentinel = -1
+    };
+
+    /* Slots of a group that matched: one bit per slot, or one byte per slot
+     * with Shift 3. Width is the number of slots in a group. */
+    template<class Mask, int Shift, int Width>
+    class SwissBitMask {
+    public:
+        explicit SwissBitMask(Mask mask) : _mask(mask) {
+        }
+
+        bool any() const {
+            return (_mask != 0);
+        }
+
+        /* First matching slot; next() drops it */
+        int lowest() const {
+            return _trailing_zeros(_mask) >> Shift;
+        }
+
+        void next() {
+            _mask &= _mask - 1;
+        }
+
+        /* Slots before the first match, after the last one */
+        int trailing() const {
+            return (_mask ? lowest() : Width);
+        }
+
+        int leading() const {
+            return (_mask ? _leading_zeros(_mask) >> Shift : Width);
+        }
+
+    private:
+        static int _trailing_zeros(unsigned int mask) {
+            return __builtin_ctz(mask);
+        }
+
+        static int _trailing_zeros(unsigned long long mask) {
+            return __builtin_ctzll(mask);
+        }
+
+        static int _leading_zeros(unsigned int mask) {
+            return __builtin_clz(mask) - (32 - (Width << Shift));
+        }
+
+        static int _leading_zeros(unsigned long long mask) {
+            return __builtin_clzll(mask) - (64 - (Width << Shift));
+        }
+
+    private:
+        Mask _mask;
+    };
+
+#if defined(__AVX2__)
+    /* 32 control bytes compared at once, AVX2 */
+    class SwissGroup {
+    public:
+        enum { width = 32 };
+        typedef SwissBitMask<unsigned int, 0, width> mask_type;
+
+        explicit SwissGroup(const swiss_ctrl* ctrl) : _ctrl(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(ctrl))) {
+        }
+
+        mask_type match(swiss_ctrl h2) const {
+            return mask_type(_movemask(_mm256_cmpeq_epi8(_mm256_set1_epi8(h2), _ctrl)));
+        }
+
+        mask_type match_empty() const {
+            return match(swiss_empty);
+        }
+
+        mask_type match_empty_or_deleted() const {
+            return mask_type(_movemask(_mm256_cmpgt_epi8(_mm256_set1_epi8(swiss_sentinel), _ctrl)));
+        }
+
+        /* Empty or deleted slots before the first full slot or the sentinel */
+        int count_free() const {
+            unsigned int taken = ~_movemask(_mm256_cmpgt_epi8(_mm256_set1_epi8(swiss_sentinel), _ctrl));
+            return (taken ? __builtin_ctz(taken) : width);
+        }
+
+    private:
+        static unsigned int _movemask(__m256i bytes) {
+            return static_cast<unsigned int>(_mm256_movemask_epi8(bytes));
+        }
+
+    private:
+        __m256i _ctrl;
+    };
+#elif defined(__SSE2__)
+    /* 16 control bytes compared at once, SSE2 */
+    class SwissGroup {
+    public:
+        enum { width = 16 };
+        typedef SwissBitMask<unsigned int, 0, width> mask_type;
+
+        explicit SwissGroup(const swiss_ctrl* ctrl) : _ctrl(_mm_loadu_si128(reinterpret_cast<const __m128i*>(ctrl))) {
+        }
+
+        mask_type match(swiss_ctrl h2) const {
+            return mask_type(_movemask(_mm_cmpeq_epi8(_mm_set1_epi8(h2), _ctrl)));
+        }
+
+        mask_type match_empty() const {
+            return match(swiss_empty);
+        }
+
+        mask_type match_empty_or_deleted() const {
+            return mask_type(_movemask(_mm_cmpgt_epi8(_mm_set1_epi8(swiss_sentinel), _ctrl)));
+        }
+
+        /* Empty or deleted slots before the first full slot or the sentinel */
+        int count_free() const {
+            return __builtin_ctz(~_movemask(_mm_cmpgt_epi8(_mm_set1_epi8(swiss_sentinel), _ctrl)));
+        }
+
+    private:
+        static unsigned int _movemask(__m128i bytes) {
+            return static_cast<unsigned int>(_mm_movemask_epi8(bytes));
+        }
+
+    private:
+        __m128i _ctrl;
+    };
+#else
+    /* 8 control bytes in a word, compared with bit tricks where there is
+     * no SSE2. match() may report a false positive next to a true match,
+     * which the key comparison then rejects. */
+    class SwissGroup {
+    public:
+        enum { width = 8 };
+        typedef SwissBitMask<unsigned long long, 3, width> mask_type;
+
+        explicit SwissGroup(const swiss_ctrl* ctrl) {
+            std::memcpy(&_ctrl, ctrl, sizeof(_ctrl));
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+            _ctrl = __builtin_bswap64(_ctrl);
+#endif
+        }
+
+        mask_type match(swiss_ctrl h2) const {
+            unsigned long long bytes = _ctrl ^ (_lsbs() * static_cast<unsigned char>(h2));
+            return mask_type((bytes - _lsbs()) & ~bytes & _msbs());
+        }
+
+        mask_type match_empty() const {
+            return mask_type(_ctrl & (~_ctrl << 6) & _msbs());
+        }
+
+        mask_type match_empty_or_deleted() const {
+            return mask_type(_ctrl & (~_ctrl << 7) & _msbs());
+        }
+
+        /* Empty or deleted slots before the first full slot or the sentinel */
+        int count_free() const {
+            unsigned long long taken = ~(_ctrl & (~_ctrl << 7)) & _msbs();
+            return (taken ? __builtin_ctzll(taken) >> 3 : width);
+        }
+
+    private:
+        static unsigned long long _lsbs() {
+            return 0x0101010101010101ULL;
+        }
+
+        static unsigned long long _msbs() {
+            return 0x8080808080808080ULL;
+        }
+
+    private:
+        unsigned long long _ctrl;
+    };
+#endif
+
+    /* SwissTable iterator: walks the slots in order, skipping the free ones
+     * a group at a time. The sentinel after the last slot stops it. */
+    template<class T>
+    class SwissIter {
+    public:
+        typedef ft::forward_iterator_tag iterator_category;
+        typedef typename ft::iterator_traits<T*>::value_type value_type;
+        typedef T* pointer;
+        typedef T& reference;
+        typedef std::ptrdiff_t difference_type;
+
+    public:
+        SwissIter() : _ctrl(nullptr), _slot(nullptr) {
+        }
+
+        SwissIter(const swiss_ctrl* ctrl, T* slot) : _ctrl(ctrl), _slot(slot) {
+        }
+
+        /* iterator to const_iterator */
+        template<class U>
+        SwissIter(const SwissIter<U>& other) : _ctrl(other.ctrl_base()), _slot(other.base()) {
+        }
+
+        SwissIter(const SwissIter& other) : _ctrl(other._ctrl), _slot(other._slot) {
+        }
+
+        SwissIter& operator=(const SwissIter& other) {
+            _ctrl = other._ctrl;
+            _slot = other._slot;
+            return *this;
+        }
+
+    public:
+        T* base() const {
+            return _slot;
+        }
+
+        const swiss_ctrl* ctrl_base() const {
+            return _ctrl;
+        }
+
+        reference operator*() const {
+            return *_slot;
+        }
+
+        pointer operator->() const {
+            return _slot;
+        }
+
+        SwissIter& operator++() {
+            ++_ctrl;
+            ++_slot;
+            skip_free();
+            return *this;
+        }
+
+        SwissIter operator++(int) {
+            SwissIter temp(*this);
+            ++(*this);
+            return temp;
+        }
+
+        /* Moves on to a full slot or the end */
+        void skip_free() {
+            while (*_ctrl < swiss_sentinel) {
+                int free = SwissGroup(_ctrl).count_free();
+                _ctrl += free;
+                _slot += free;
+            }
+        }
+
+    private:
+        const swiss_ctrl* _ctrl;
+        T* _slot;
+    };
+
+    template<class U, class V>
+    bool operator==(const SwissIter<U>& lhs, const SwissIter<V>& rhs) {
+        return (lhs.base() == rhs.base());
+    }
+
+    template<class U, class V>
+    bool operator!=(const SwissIter<U>& lhs, const SwissIter<V>& rhs) {
+        return (lhs.base() != rhs.base());
+    }
+
+    /* Open addressing after the Swiss table design. Elements are stored
+     * inline in one slot array and one control byte per slot sits in a
+     * second array. A lookup hashes once, starts at a slot picked by the
+     * high bits and compares the 7 low bits against a whole group of
+     * control bytes in a few instructions; only slots whose byte matches
+     * have their key compared. Groups are probed quadratically until one
+     * holds an empty slot. Erased slots become tombstones unless no probe
+     * can have passed them.
+     *
+     * Capacity is a power of two minus one. The control array holds a
+     * sentinel after the last slot, then copies of the first group's bytes,
+     * so a group can be loaded at any slot. At most 7/8 of the slots fill
+     * up before the table grows; rehashing moves every element, so any
+     * insert may invalidate iterators, erase does not.
+     *
+     * Hash hashes values and the key types lookups use; Equal compares such
+     * a key, or a value, with a value. The container provides both, as it
+     * provides Compare to the Treap. */
+    template<class Value, class Hash, class Equal, class Alloc = std::allocator<Value> >
+    class SwissTable {
+    public:
+        typedef Value value_type;
+        typedef Hash hasher;
+        typedef Equal key_equal;
+        typedef Alloc allocator_type;
+        typedef typename allocator_type::size_type size_type;
+        typedef typename allocator_type::difference_type difference_type;
+        typedef typename allocator_type::pointer pointer;
+        typedef typename allocator_type::template rebind<swiss_ctrl>::other ctrl_allocator;
+        typedef SwissIter<value_type> iterator;
+        typedef SwissIter<const value_type> const_iterator;
+
+        /* Place for a new element, from locate(): a free slot on the probe
+         * sequence of the hash */
+        struct slot_type {
+            size_type index;
+            size_t hash;
+        };
+
+    public:
+        SwissTable(const hasher& hash, const key_equal& equal, const allocator_type& allocator = allocator_type())
+                : _allocator(allocator), _ctrl_allocator(allocator), _hash(hash), _equal(equal) {
+            _reset();
+        }
+
+        SwissTable(const SwissTable& other)
+                : _allocator(other._allocator), _ctrl_allocator(other._ctrl_allocator), _hash(other._hash), _equal(other._equal) {
+            _reset();
+            _copy(other);
+        }
+
+        SwissTable& operator=(const SwissTable& other) {
+            if (this != &other) {
+                _release();
+                _hash = other._hash;
+                _equal = other._equal;
+                _copy(other);
+            }
+            return *this;
+        }
+
+        ~SwissTable() {
+            _release();
+        }
+
+    /* Iterators */
+    public:
+        iterator begin() {
+            iterator it(_ctrl, _slots);
+            it.skip_free();
+            return it;
+        }
+
+        const_iterator begin() const {
+            const_iterator it(_ctrl, _slots);
+            it.skip_free();
+            return it;
+        }
+
+        iterator end() {
+            return iterator(_ctrl + _capacity, _slots + _capacity);
+        }
+
+        const_iterator end() const {
+            return const_iterator(_ctrl + _capacity, _slots + _capacity);
+        }
+
+    /* Capacity */
+    public:
+        size_type size() const {
+            return _size;
+        }
+
+        /* Number of slots */
+        size_type capacity() const {
+            return _capacity;
+        }
+
+        /* Slots needed for count elements without growing, in bulk */
+        void reserve(size_type count) {
+            if (count > _size + _growth_left) {
+                _resize(_capacity_for(count));
+            }
+        }
+
+        /* Resizes to the smallest capacity that holds count elements, and
+         * the current ones; drops the tombstones */
+        void rehash(size_type count) {
+            if (count < _size) {
+                count = _size;
+            }
+            size_type capacity = (count ? _capacity_for(count) : 0);
+            if (capacity != _capacity || _size + _growth_left < _growth(_capacity)) {
+                _resize(capacity);
+            }
+        }
+
+    /* Modifiers */
+    public:
+        /* Destroys the elements, keeps the slots */
+        void clear() {
+            if (_size > 0) {
+                _destroy_all();
+            }
+            if (_capacity > 0) {
+                _clear_ctrl();
+            }
+            _size = 0;
+            _growth_left = _growth(_capacity);
+        }
+
+        ft::pair<iterator, bool> insert(const value_type& value) {
+            slot_type slot;
+            iterator it = locate(value, slot);
+            if (it != end()) {
+                return ft::make_pair(it, false);
+            }
+            return ft::make_pair(insert_at(slot, value), true);
+        }
+
+        /* Finds key with one hash. Returns its position, or end() and the
+         * slot to pass to insert_at(). */
+        template<class K>
+        iterator locate(const K& key, slot_type& slot) {
+            slot.hash = _hash_of(key);
+            slot.index = _find(key, slot.hash);
+            if (slot.index != _capacity) {
+                return _iter(slot.index);
+            }
+            slot.index = _find_free(slot.hash);
+            return end();
+        }
+
+        /* Constructs value in a slot returned by locate(), growing first
+         * when no empty slot may be taken. The slot is invalidated by any
+         * other modification. */
+        iterator insert_at(const slot_type& slot, const value_type& value) {
+            size_type index = slot.index;
+            if (_growth_left == 0 && _ctrl[index] != swiss_deleted) {
+                _grow();
+                index = _find_free(slot.hash);
+            }
+            _allocator.construct(_slots + index, value);
+            _growth_left -= (_ctrl[index] == swiss_empty);
+            _set_ctrl(index, _h2(slot.hash));
+            ++_size;
+            return _iter(index);
+        }
+
+        /* Returns the iterator following pos */
+        iterator erase(iterator pos) {
+            size_type index = pos.base() - _slots;
+            _allocator.destroy(_slots + index);
+            --_size;
+            size_type before = (index - SwissGroup::width) & _capacity;
+            typename SwissGroup::mask_type empty_after = SwissGroup(_ctrl + index).match_empty();
+            typename SwissGroup::mask_type empty_before = SwissGroup(_ctrl + before).match_empty();
+            bool never_full = (empty_after.any() && empty_before.any()
+                               && empty_after.trailing() + empty_before.leading() < SwissGroup::width);
+            _set_ctrl(index, (never_full ? swiss_empty : swiss_deleted));
+            _growth_left += never_full;
+            ++pos;
+            return pos;
+        }
+
+        iterator erase(iterator first, iterator last) {
+            while (first != last) {
+                first = erase(first);
+            }
+            return last;
+        }
+
+        void swap(SwissTable& other) {
+            ft::swap(_allocator, other._allocator);
+            ft::swap(_ctrl_allocator, other._ctrl_allocator);
+            ft::swap(_hash, other._hash);
+            ft::swap(_equal, other._equal);
+            ft::swap(_ctrl, other._ctrl);
+            ft::swap(_slots, other._slots);
+            ft::swap(_capacity, other._capacity);
+            ft::swap(_size, other._size);
+            ft::swap(_growth_left, other._growth_left);
+        }
+
+    /* Lookup */
+    public:
+        template<class K>
+        iterator find(const K& key) {
+            return _iter(_find(key, _hash_of(key)));
+        }
+
+        template<class K>
+        const_iterator find(const K& key) const {
+            size_type index = _find(key, _hash_of(key));
+            return const_iterator(_ctrl + index, _slots + index);
+        }
+
+    /* Observers */
+    public:
+        hasher hash_function() const {
+            return _hash;
+        }
+
+        key_equal key_eq() const {
+            return _equal;
+        }
+
+        allocator_type get_allocator() const {
+            return _allocator;
+        }
+
+    /* private helpers */
+    private:
+        /* Scrambles a hash, so that hashers returning keys as they are
+         * still spread them; the low 7 bits go to the control byte */
+        template<class K>
+        size_t _hash_of(const K& key) const {
+            unsigned long long hash = _hash(key);
+            hash ^= hash >> 33;
+            hash *= 0xff51afd7ed558ccdULL;
+            hash ^= hash >> 33;
+            hash *= 0xc4ceb9fe1a85ec53ULL;
+            hash ^= hash >> 33;
+            return static_cast<size_t>(hash);
+        }
+
+        static size_t _h1(size_t hash) {
+            return hash >> 7;
+        }
+
+        static swiss_ctrl _h2(size_t hash) {
+            return static_cast<swiss_ctrl>(hash & 0x7f);
+        }
+
+        /* Slot holding key, _capacity when there is none */
+        template<class K>
+        size_type _find(const K& key, size_t hash) const {
+            swiss_ctrl h2 = _h2(hash);
+            size_type pos = _h1(hash) & _capacity;
+            for (size_type step = SwissGroup::width; ; step += SwissGroup::width) {
+                SwissGroup group(_ctrl + pos);
+                for (typename SwissGroup::mask_type match = group.match(h2); match.any(); match.next()) {
+                    size_type index = (pos + match.lowest()) & _capacity;
+                    if (_equal(key, _slots[index])) {
+                        return index;
+                    }
+                }
+                if (group.match_empty().any()) {
+                    return _capacity;
+                }
+                pos = (pos + step) & _capacity;
+            }
+        }
+
+        /* First empty or deleted slot on the probe sequence of hash */
+        size_type _find_free(size_t hash) const {
+            size_type pos = _h1(hash) & _capacity;
+            for (size_type step = SwissGroup::width; ; step += SwissGroup::width) {
+                typename SwissGroup::mask_type free = SwissGroup(_ctrl + pos).match_empty_or_deleted();
+                if (free.any()) {
+                    return (pos + free.lowest()) & _capacity;
+                }
+                pos = (pos + step) & _capacity;
+            }
+        }
+
+        iterator _iter(size_type index) {
+            return iterator(_ctrl + index, _slots + index);
+        }
+
+        /* Sets the control byte of a slot, and its copy after the sentinel
+         * for the first group's slots */
+        void _set_ctrl(size_type index, swiss_ctrl ctrl) {
+            _ctrl[index] = ctrl;
+            _ctrl[((index - _cloned()) & _capacity) + (_cloned() & _capacity)] = ctrl;
+        }
+
+        static size_type _cloned() {
+            return SwissGroup::width - 1;
+        }
+
+        /* Elements a capacity holds before growing: 7/8, and one slot is
+         * always left empty to end probes */
+        static size_type _growth(size_type capacity) {
+            if (capacity == 0) {
+                return 0;
+            }
+            return capacity - (capacity / 8 > 0 ? capacity / 8 : 1);
+        }
+
+        static size_type _capacity_for(size_type count) {
+            size_type capacity = _cloned();
+            while (_growth(capacity) < count) {
+                capacity = capacity * 2 + 1;
+            }
+            return capacity;
+        }
+
+        /* Out of empty slots: drops the tombstones when they take up much of
+         * the table, doubles it otherwise */
+        void _grow() {
+            if (_capacity > static_cast<size_type>(SwissGroup::width) && _size * 32 <= _capacity * 25) {
+                _resize(_capacity);
+            } else {
+                _resize(_capacity ? _capacity * 2 + 1 : _cloned());
+            }
+        }
+
+        /* Moves every element into fresh arrays of capacity slots */
+        void _resize(size_type capacity) {
+            swiss_ctrl* old_ctrl = _ctrl;
+            pointer old_slots = _slots;
+            size_type old_capacity = _capacity;
+            _allocate(capacity);
+            _growth_left = _growth(capacity) - _size;
+            for (size_type i = 0; i < old_capacity; ++i) {
+                if (old_ctrl[i] >= 0) {
+                    size_t hash = _hash_of(old_slots[i]);
+                    size_type index = _find_free(hash);
+                    _allocator.construct(_slots + index, old_slots[i]);
+                    _set_ctrl(index, _h2(hash));
+                    _allocator.destroy(old_slots + i);
+                }
+            }
+            _deallocate(old_ctrl, old_slots, old_capacity);
+        }
+
+        /* Same capacity, same slots, same control bytes */
+        void _copy(const SwissTable& other) {
+            if (other._size == 0) {
+                return;
+            }
+            _allocate(other._capacity);
+            std::memcpy(_ctrl, other._ctrl, _capacity + SwissGroup::width);
+            for (size_type i = 0; i < _capacity; ++i) {
+                if (_ctrl[i] >= 0) {
+                    _allocator.construct(_slots + i, other._slots[i]);
+                }
+            }
+            _size = other._size;
+            _growth_left = other._growth_left;
+        }
+
+        void _allocate(size_type capacity) {
+            _capacity = capacity;
+            if (capacity == 0) {
+                _ctrl = _empty_group();
+                _slots = nullptr;
+                return;
+            }
+            _ctrl = _ctrl_allocator.allocate(capacity + SwissGroup::width);
+            _slots = _allocator.allocate(capacity);
+            _clear_ctrl();
+        }
+
+        void _clear_ctrl() {
+            std::memset(_ctrl, swiss_empty, _capacity + SwissGroup::width);
+            _ctrl[_capacity] = swiss_sentinel;
+        }
+
+        void _destroy_all() {
+            if (!ft::is_trivially_destructible<value_type>::value) {
+                for (size_type i = 0; i < _capacity; ++i) {
+                    if (_ctrl[i] >= 0) {
+                        _allocator.destroy(_slots + i);
+                    }
+                }
+            }
+        }
+
+        void _deallocate(swiss_ctrl* ctrl, pointer slots, size_type capacity) {
+            if (capacity > 0) {
+                _ctrl_allocator.deallocate(ctrl, capacity + SwissGroup::width);
+                _allocator.deallocate(slots, capacity);
+            }
+        }
+
+        void _release() {
+            _destroy_all();
+            _deallocate(_ctrl, _slots, _capacity);
+            _reset();
+        }
+
+        void _reset() {
+            _ctrl = _empty_group();
+            _slots = nullptr;
+            _capacity = 0;
+            _size = 0;
+            _growth_left = 0;
+        }
+
+        /* Control bytes of a table without slots: lookups stop at once and
+         * iteration starts at the sentinel. Never written to. */
+        static swiss_ctrl* _empty_group() {
+            static swiss_ctrl group[32] = {
+                swiss_sentinel, swiss_empty, swiss_empty, swiss_empty, swiss_empty, swiss_empty, swiss_empty, swiss_empty,
+                swiss_empty, swiss_empty, swiss_empty, swiss_empty, swiss_empty, swiss_empty, swiss_empty, swiss_empty,
+                swiss_empty, swiss_empty, swiss_empty, swiss_empty, swiss_empty, swiss_empty, swiss_empty, swiss_empty,
+                swiss_empty, swiss_empty, swiss_empty, swiss_empty, swiss_empty, swiss_empty, swiss_empty, swiss_empty
+            };
+            return group;
+        }
+
+    private:
+        allocator_type _allocator;
+        ctrl_allocator _ctrl_allocator;
+        hasher _hash;
+        key_equal _equal;
+        swiss_ctrl* _ctrl;
+        pointer _slots;
+        size_type _capacity;
+        size_type _size;
+        size_type _growth_left;
+    };
+
+} //namespace ft
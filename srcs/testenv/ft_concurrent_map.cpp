@@ -0,0 +1,116 @@
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "../map.hpp"
+#include "../concurrent_map.hpp"
+#include "../pair.hpp"
+
+/* Many writers: 1 to 64 threads share a fixed number of inserts of random
+ * keys into an empty map, then a fixed number of lookups. The lock-free
+ * ft::concurrent_map against the default ft::map behind a mutex. */
+
+const long inserts = 1 << 19;
+const long lookups = 1 << 20;
+
+typedef std::chrono::steady_clock steady;
+
+double seconds(steady::time_point start) {
+    return std::chrono::duration<double>(steady::now() - start).count();
+}
+
+unsigned next(unsigned& state) {
+    state = state * 1103515245u + 12345u;
+    return (state >> 4);
+}
+
+struct locked_map {
+    ft::map<int, int> map;
+    std::mutex lock;
+
+    struct session {
+        explicit session(locked_map& self) : self(self) {
+        }
+
+        bool insert(int key) {
+            std::lock_guard<std::mutex> guard(self.lock);
+            return (self.map.insert(ft::make_pair(key, key)).second);
+        }
+
+        bool contains(int key) {
+            std::lock_guard<std::mutex> guard(self.lock);
+            return (self.map.find(key) != self.map.end());
+        }
+
+        locked_map& self;
+    };
+};
+
+struct shared_map : ft::concurrent_map<int, int> {
+    struct session : ft::concurrent_map<int, int>::session {
+        explicit session(shared_map& self) : ft::concurrent_map<int, int>::session(self) {
+        }
+
+        bool insert(int key) {
+            return (ft::concurrent_map<int, int>::session::insert(ft::make_pair(key, key)).second);
+        }
+
+        bool contains(int key) {
+            return (find(key) != end());
+        }
+    };
+};
+
+template<class Map, class Body>
+double parallel(Map& map, int threads, Body body) {
+    std::vector<std::thread> workers;
+    steady::time_point start = steady::now();
+    for (int t = 0; t < threads; ++t) {
+        workers.push_back(std::thread([&map, &body, t] {
+            typename Map::session session(map);
+            body(session, t);
+        }));
+    }
+    for (int t = 0; t < threads; ++t) {
+        workers[t].join();
+    }
+    return seconds(start);
+}
+
+template<class Map>
+void run(const char* name, int threads) {
+    Map map;
+    std::vector<long> found(threads);
+    double insert = parallel(map, threads, [&](typename Map::session& session, int t) {
+        unsigned state = t + 1;
+        long added = 0;
+        for (long i = 0; i < inserts / threads; ++i) {
+            added += session.insert(next(state));
+        }
+        found[t] = added;
+    });
+    double lookup = parallel(map, threads, [&](typename Map::session& session, int t) {
+        unsigned state = t + 1;
+        long hits = 0;
+        for (long i = 0; i < lookups / threads; ++i) {
+            hits += session.contains(next(state));
+        }
+        found[t] += hits;
+    });
+    long total = 0;
+    for (int t = 0; t < threads; ++t) {
+        total += found[t];
+    }
+    std::cout << name << "\t" << threads << " threads\t" << inserts / insert / 1e6 << " M inserts/s, "
+              << lookups / lookup / 1e6 << " M lookups/s\t" << total << std::endl;
+}
+
+int main() {
+    for (int threads = 1; threads <= 64; threads *= 2) {
+        run<locked_map>("mutex", threads);
+        run<shared_map>("skiplist", threads);
+    }
+}
@@ -0,0 +1,41 @@
+#include <map>
+#include <ctime>
+#include <vector>
+#include <iostream>
+
+#include "../map.hpp"
+#include "../flat_map.hpp"
+#include "../pair.hpp"
+
+using namespace ft;
+
+/* Build once, read many: bulk load from unsorted pairs, then lookups only */
+template<class Map>
+void run(const char* name, const std::vector<pair<int, int> >& source) {
+    clock_t start = clock();
+    Map data(source.begin(), source.end());
+    double build = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+    start = clock();
+    size_t found = 0;
+    srand(2);
+    for (size_t i = 0; i < 8 * source.size(); ++i) {
+        int key = rand() % (int)(2 * source.size());
+        found += data.count(key);
+        found += (data.lower_bound(key) != data.end());
+    }
+    double read = (double)(clock() - start) / CLOCKS_PER_SEC;
+    std::cout << name << ": build " << build << "s, " << 16 * source.size() / read << " lookups/s, "
+              << found << " hits" << std::endl;
+}
+
+int main() {
+    size_t testSize = 1000000;
+    std::vector<pair<int, int> > source;
+    srand(1);
+    for (size_t i = 0; i < testSize; ++i) {
+        source.push_back(make_pair(rand() % (int)(2 * testSize), (int)i));
+    }
+    run<map<int, int> >("map", source);
+    run<flat_map<int, int> >("flat_map", source);
+}
@@ -0,0 +1,73 @@
+#include <cstdlib>
+#include <ctime>
+#include <iostream>
+#include <vector>
+
+#include "../map.hpp"
+#include "../flat_map.hpp"
+#include "../frozen_map.hpp"
+#include "../pair.hpp"
+
+using namespace ft;
+
+/* Read-only tables: lookups of random keys, half of them absent, in the
+ * default map, the binary-searched flat_map and the Eytzinger frozen_map
+ * built from it, at sizes from 64K to 4M; other sizes come from the
+ * command line, e.g. ./app 16000000 */
+
+const size_t lookups = 4000000;
+
+double elapsed(clock_t start, size_t count) {
+    return (double)(clock() - start) * 1e9 / CLOCKS_PER_SEC / count;
+}
+
+template<class Map>
+void run(const char* name, const Map& data, const std::vector<int>& probes, size_t bytes) {
+    long sum = 0;
+    clock_t start = clock();
+    for (size_t i = 0; i < lookups; ++i) {
+        typename Map::const_iterator it = data.find(probes[i]);
+        if (it != data.end()) {
+            sum += it->second;
+        }
+    }
+    double find = elapsed(start, lookups);
+
+    start = clock();
+    for (size_t i = 0; i < lookups; ++i) {
+        sum += (data.lower_bound(probes[i]) != data.end());
+    }
+    double lower = elapsed(start, lookups);
+
+    std::cout << data.size() << "\t" << name << "\tfind " << (long)find << " ns, lower_bound " << (long)lower
+              << " ns, " << bytes / data.size() << " bytes per element\t" << sum << std::endl;
+}
+
+void compare(size_t size) {
+    map<int, int> tree;
+    for (size_t i = 0; i < size; ++i) {
+        tree.insert(make_pair((int)(i * 2), (int)i));
+    }
+    std::vector<int> probes(lookups);
+    for (size_t i = 0; i < lookups; ++i) {
+        probes[i] = rand() % (int)(size * 2);
+    }
+    run("map", tree, probes, size * (sizeof(pair<const int, int>) + sizeof(size_t) + 3 * sizeof(void*)));
+    flat_map<int, int> flat(tree.begin(), tree.end());
+    run("flat_map", flat, probes, size * (sizeof(int) + sizeof(int)));
+    frozen_map<int, int> frozen(tree.begin(), tree.end());
+    run("frozen_map", frozen, probes, (size + 1) * (sizeof(int) + sizeof(int)));
+}
+
+int main(int argc, char** argv) {
+    srand(1);
+    if (argc > 1) {
+        for (int i = 1; i < argc; ++i) {
+            compare(std::strtoul(argv[i], nullptr, 10));
+        }
+        return 0;
+    }
+    compare(1 << 16);
+    compare(1 << 20);
+    compare(1 << 22);
+}
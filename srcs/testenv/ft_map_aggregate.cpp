@@ -0,0 +1,127 @@
+#include <cstdlib>
+#include <ctime>
+#include <iostream>
+#include <vector>
+
+#include "../map.hpp"
+#include "../pair.hpp"
+#include "../vector.hpp"
+
+using namespace ft;
+
+/* Sum and minimum of the samples in sliding time windows: a walk from
+ * lower_bound() over the window against aggregate() on a map keeping
+ * both per subtree, which must agree. Then the largest samples of a
+ * window, an aggregate that owns memory, on a series rebuilt and cleared
+ * a few times. */
+
+typedef monoid_pair<mapped_sum<long>, mapped_min<int> > window_stats;
+typedef map<int, int, std::less<int>, std::allocator<pair<const int, int> >, aggregate_tree<window_stats> > Series;
+
+/* The largest values of a subtree, in decreasing order */
+struct top_values {
+    typedef ft::vector<int> value_type;
+    enum { count = 4 };
+
+    static value_type identity() {
+        return value_type();
+    }
+
+    static value_type combine(const value_type& lhs, const value_type& rhs) {
+        value_type top;
+        size_t i = 0;
+        size_t j = 0;
+        while (top.size() < (size_t)count && (i < lhs.size() || j < rhs.size())) {
+            if (j == rhs.size() || (i < lhs.size() && lhs[i] >= rhs[j])) {
+                top.push_back(lhs[i++]);
+            } else {
+                top.push_back(rhs[j++]);
+            }
+        }
+        return top;
+    }
+
+    template<class Pair>
+    static value_type lift(const Pair& element) {
+        return value_type(1, element.second);
+    }
+};
+
+typedef map<int, int, std::less<int>, std::allocator<pair<const int, int> >, aggregate_tree<top_values> > Leaders;
+
+const int samples = 1000000;
+const int queries = 20000;
+
+double elapsed(clock_t start, int count) {
+    return (double)(clock() - start) * 1e9 / CLOCKS_PER_SEC / count;
+}
+
+int main() {
+    srand(1);
+    Series series;
+    for (int i = 0; i < samples; ++i) {
+        series.insert(ft::make_pair(i * 10 + rand() % 10, rand() % 1000));
+    }
+
+    std::vector<int> starts(queries);
+    std::vector<window_stats::value_type> walked(queries);
+    for (int window = 100; window <= 1000000; window *= 100) {
+        for (int i = 0; i < queries; ++i) {
+            starts[i] = rand() % (samples * 10);
+        }
+        long check = 0;
+        clock_t start = clock();
+        for (int i = 0; i < queries; ++i) {
+            int lo = starts[i];
+            long sum = 0;
+            int low = mapped_min<int>::identity();
+            for (Series::const_iterator it = series.lower_bound(lo); it != series.end() && it->first < lo + window; ++it) {
+                sum += it->second;
+                low = (it->second < low ? it->second : low);
+            }
+            walked[i] = window_stats::value_type(sum, low);
+        }
+        double walk = elapsed(start, queries);
+
+        start = clock();
+        for (int i = 0; i < queries; ++i) {
+            window_stats::value_type stats = series.aggregate(starts[i], starts[i] + window);
+            if (stats.first != walked[i].first || stats.second != walked[i].second) {
+                std::cout << "aggregate of [" << starts[i] << ", " << starts[i] + window << ") differs from the walk" << std::endl;
+                return 1;
+            }
+            check += stats.first + stats.second;
+        }
+        double aggregate = elapsed(start, queries);
+
+        std::cout << "window " << window << "\twalk " << (long)walk << " ns, aggregate " << (long)aggregate
+                  << " ns per query\t" << check << std::endl;
+    }
+
+    Leaders leaders;
+    long check = 0;
+    clock_t start = clock();
+    for (int round = 0; round < 5; ++round) {
+        leaders.clear();
+        for (int i = 0; i < samples / 5; ++i) {
+            leaders.insert(ft::make_pair(i * 10 + rand() % 10, rand() % 1000));
+        }
+        for (int i = 0; i < queries; ++i) {
+            int lo = rand() % (samples * 2);
+            top_values::value_type top = leaders.aggregate(lo, lo + 10000);
+            check += (top.empty() ? 0 : top[0]);
+            if (i % 100 == 0) {
+                top_values::value_type walked_top;
+                for (Leaders::const_iterator it = leaders.lower_bound(lo); it != leaders.end() && it->first < lo + 10000; ++it) {
+                    walked_top = top_values::combine(walked_top, top_values::lift(*it));
+                }
+                if (!(walked_top == top)) {
+                    std::cout << "top values of [" << lo << ", " << lo + 10000 << ") differ from the walk" << std::endl;
+                    return 1;
+                }
+            }
+        }
+    }
+    std::cout << "top " << (int)top_values::count << " of window 10000\t" << (long)elapsed(start, 5 * queries)
+              << " ns per query, builds included\t" << check << std::endl;
+}
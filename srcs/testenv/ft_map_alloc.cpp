@@ -0,0 +1,54 @@
+#include <map>
+#include <ctime>
+#include <memory>
+#include <iostream>
+
+#include "../map.hpp"
+#include "../pair.hpp"
+
+using namespace ft;
+
+/* Stateful allocator: counts calls into the counter it was built with */
+template<class T>
+struct counting_allocator : public std::allocator<T> {
+    template<class U>
+    struct rebind {
+        typedef counting_allocator<U> other;
+    };
+
+    size_t* calls;
+
+    explicit counting_allocator(size_t* calls) : calls(calls) {
+    }
+
+    template<class U>
+    counting_allocator(const counting_allocator<U>& other) : std::allocator<T>(other), calls(other.calls) {
+    }
+
+    T* allocate(size_t n, const void* = 0) {
+        ++*calls;
+        return std::allocator<T>::allocate(n);
+    }
+};
+
+int main() {
+    typedef counting_allocator<pair<const int, int> > allocator;
+    size_t calls = 0;
+    size_t testSize = 1000000;
+    std::less<int> compare;
+    map<int, int, std::less<int>, allocator> data(compare, allocator(&calls));
+
+    clock_t start = clock();
+    for (int round = 0; round < 3; ++round) {
+        srand(round);
+        for (size_t i = 0; i < testSize; ++i) {
+            data.insert(make_pair(rand() % (int)testSize, (int)i));
+        }
+        for (size_t i = 0; i < testSize; ++i) {
+            data.erase(rand() % (int)testSize);
+        }
+        data.clear();
+    }
+    std::cout << calls << " allocations, "
+              << (double)(clock() - start) / CLOCKS_PER_SEC << "s" << std::endl;
+}
@@ -0,0 +1,115 @@
+#include <ctime>
+#include <iostream>
+#include <vector>
+
+#include "../map.hpp"
+#include "../pair.hpp"
+
+using namespace ft;
+
+/* Balancing policies against three workloads: inserts, lookups and erases
+ * of uniform random keys, of sequential keys, and Zipfian lookups (s = 1)
+ * over keys inserted in random order */
+
+const int size = 500000;
+const int lookups = 2000000;
+
+/* Scatters ranks over the key space, so that hot keys are not neighbours */
+int scatter(int rank) {
+    return (int)(((unsigned)rank * 2654435761U) % (unsigned)size);
+}
+
+/* Zipfian ranks by inverting the cumulative distribution */
+std::vector<int> zipf(int count) {
+    std::vector<double> cdf(size);
+    double sum = 0;
+    for (int i = 0; i < size; ++i) {
+        sum += 1.0 / (i + 1);
+        cdf[i] = sum;
+    }
+    std::vector<int> ranks(count);
+    for (int i = 0; i < count; ++i) {
+        double u = (double)rand() / RAND_MAX * sum;
+        ranks[i] = (int)(std::lower_bound(cdf.begin(), cdf.end(), u) - cdf.begin());
+        if (ranks[i] == size) {
+            ranks[i] = size - 1;
+        }
+    }
+    return ranks;
+}
+
+double elapsed(clock_t start, int count) {
+    return (double)(clock() - start) * 1e9 / CLOCKS_PER_SEC / count;
+}
+
+template<class Map>
+void run(const char* name, const char* workload, const std::vector<int>& inserts, const std::vector<int>& reads) {
+    Map data;
+    clock_t start = clock();
+    for (size_t i = 0; i < inserts.size(); ++i) {
+        data.insert(make_pair(inserts[i], (int)i));
+    }
+    double insert = elapsed(start, inserts.size());
+
+    long sum = 0;
+    start = clock();
+    for (size_t i = 0; i < reads.size(); ++i) {
+        typename Map::iterator it = data.find(reads[i]);
+        if (it != data.end()) {
+            sum += it->second;
+        }
+    }
+    double find = elapsed(start, reads.size());
+
+    start = clock();
+    for (size_t i = 0; i < inserts.size(); ++i) {
+        data.erase(inserts[i]);
+    }
+    double erase = elapsed(start, inserts.size());
+
+    std::cout << workload << "\t" << name << "\tinsert " << (long)insert << " ns, find " << (long)find
+              << " ns, erase " << (long)erase << " ns\t" << sum << std::endl;
+}
+
+template<class Tree>
+void run_tree(const char* name, const char* workload, const std::vector<int>& inserts, const std::vector<int>& reads) {
+    run<map<int, int, std::less<int>, std::allocator<pair<const int, int> >, Tree> >(name, workload, inserts, reads);
+}
+
+void matrix(const char* workload, const std::vector<int>& inserts, const std::vector<int>& reads) {
+    run_tree<treap_tree>("avl", workload, inserts, reads);
+    run_tree<red_black_tree>("red-black", workload, inserts, reads);
+    run_tree<randomized_tree>("treap", workload, inserts, reads);
+    run_tree<splay_tree>("splay", workload, inserts, reads);
+}
+
+int main() {
+    srand(1);
+    std::vector<int> inserts(size);
+    std::vector<int> reads(lookups);
+
+    for (int i = 0; i < size; ++i) {
+        inserts[i] = rand();
+    }
+    for (int i = 0; i < lookups; ++i) {
+        reads[i] = inserts[rand() % size];
+    }
+    matrix("uniform", inserts, reads);
+
+    for (int i = 0; i < size; ++i) {
+        inserts[i] = i;
+    }
+    for (int i = 0; i < lookups; ++i) {
+        reads[i] = i % size;
+    }
+    matrix("sequential", inserts, reads);
+
+    for (int i = 0; i < size; ++i) {
+        std::swap(inserts[i], inserts[rand() % size]);
+    }
+    std::vector<int> ranks = zipf(lookups);
+    for (int i = 0; i < lookups; ++i) {
+        reads[i] = scatter(ranks[i]);
+    }
+    matrix("zipfian", inserts, reads);
+}
@@ -0,0 +1,65 @@
+#include <cstdlib>
+#include <ctime>
+#include <iostream>
+#include <vector>
+
+#include "../map.hpp"
+#include "../pair.hpp"
+
+using namespace ft;
+
+/* Requests of 32 independent keys, looked up with a loop of find() and
+ * with one find_many() per request; a map that fits the cache and one
+ * several times the size of the last level cache */
+
+const int request = 32;
+const int lookups = 4000000;
+
+double elapsed(clock_t start, int count) {
+    return (double)(clock() - start) * 1e9 / CLOCKS_PER_SEC / count;
+}
+
+void run(int size) {
+    typedef map<int, int> Map;
+    Map data;
+    std::vector<int> inserted(size);
+    for (int i = 0; i < size; ++i) {
+        inserted[i] = rand();
+        data.insert(ft::make_pair(inserted[i], i));
+    }
+    std::vector<int> keys(lookups);
+    for (int i = 0; i < lookups; ++i) {
+        keys[i] = (i % 4 ? inserted[rand() % size] : rand());
+    }
+
+    long sum = 0;
+    clock_t start = clock();
+    for (int i = 0; i < lookups; ++i) {
+        Map::iterator it = data.find(keys[i]);
+        if (it != data.end()) {
+            sum += it->second;
+        }
+    }
+    double single = elapsed(start, lookups);
+
+    std::vector<Map::iterator> found(request);
+    start = clock();
+    for (int i = 0; i < lookups; i += request) {
+        data.find_many(keys.begin() + i, keys.begin() + i + request, found.begin());
+        for (int j = 0; j < request; ++j) {
+            if (found[j] != data.end()) {
+                sum += found[j]->second;
+            }
+        }
+    }
+    double batch = elapsed(start, lookups);
+
+    std::cout << size << " keys\tfind " << (long)single << " ns, find_many " << (long)batch << " ns per key\t"
+              << sum << std::endl;
+}
+
+int main() {
+    srand(1);
+    run(50000);
+    run(8000000);
+}
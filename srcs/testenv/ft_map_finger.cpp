@@ -0,0 +1,67 @@
+#include <cstdlib>
+#include <ctime>
+#include <iostream>
+
+#include "../map.hpp"
+#include "../pair.hpp"
+
+using namespace ft;
+
+/* Lookups with key locality on a 1M-key map, default tree against finger
+ * search: the count() x4 then operator[] pattern of ft_map.cpp on one key
+ * at a time, and a walk that moves a few keys away between lookups. */
+
+const int size = 1000000;
+const int steps = 2000000;
+
+double elapsed(clock_t start) {
+    return (double)(clock() - start) * 1e3 / CLOCKS_PER_SEC;
+}
+
+template<class Map>
+void run(const char* name) {
+    Map data;
+    for (int i = 0; i < size; ++i) {
+        data.insert(ft::make_pair(i * 2, i));
+    }
+    long found = 0;
+
+    clock_t start = clock();
+    for (int i = 0; i < steps / 5; ++i) {
+        int key = (rand() % size) * 2;
+        found += data.count(key);
+        found += data.count(key);
+        found += data.count(key);
+        found += data.count(key);
+        data[key] += 1;
+    }
+    double repeated = elapsed(start);
+
+    int key = size;
+    start = clock();
+    for (int i = 0; i < steps; ++i) {
+        key += rand() % 33 - 16;
+        if (key < 0 || key >= size * 2) {
+            key = size;
+        }
+        found += (data.find(key) != data.end());
+        found += (data.lower_bound(key) != data.end());
+    }
+    double walk = elapsed(start);
+
+    start = clock();
+    for (int i = 0; i < steps; ++i) {
+        found += data.count(rand() % (size * 2));
+    }
+    double scattered = elapsed(start);
+
+    std::cout << name << "\trepeated key " << repeated << " ms, walk " << walk << " ms, scattered "
+              << scattered << " ms\t" << found << std::endl;
+}
+
+int main() {
+    srand(1);
+    run<map<int, int> >("default");
+    srand(1);
+    run<map<int, int, std::less<int>, std::allocator<pair<const int, int> >, finger_tree> >("finger");
+}
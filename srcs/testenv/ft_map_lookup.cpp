@@ -0,0 +1,46 @@
+#include <map>
+#include <ctime>
+#include <cstring>
+#include <iostream>
+#include <sstream>
+
+#include "../map.hpp"
+#include "../pair.hpp"
+
+using namespace ft;
+
+struct Heavy {
+    char payload[1024];
+    std::string name;
+
+    Heavy() : name("unnamed heavy value") {
+        std::memset(payload, 0, sizeof(payload));
+    }
+};
+
+int main() {
+    map<std::string, Heavy> data;
+    size_t testSize = 100000;
+    std::string* keys = new std::string[testSize];
+
+    for (size_t i = 0; i < testSize; ++i) {
+        std::ostringstream key;
+        key << "session-key-" << (i * 7919) % testSize;
+        keys[i] = key.str();
+        data[keys[i]].payload[0] = (char)i;
+    }
+
+    clock_t start = clock();
+    size_t found = 0;
+    for (size_t round = 0; round < 10; ++round) {
+        for (size_t i = 0; i < testSize; ++i) {
+            found += data.count(keys[i]);
+            found += (data.find(keys[(i + round) % testSize]) != data.end());
+            found += (data.lower_bound(keys[i]) != data.end());
+            data[keys[i]].payload[1] = (char)round;
+        }
+    }
+    std::cout << found << " hits, " << 4 * 10 * testSize / ((double)(clock() - start) / CLOCKS_PER_SEC)
+              << " lookups/s" << std::endl;
+    delete[] keys;
+}
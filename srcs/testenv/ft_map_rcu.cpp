@@ -0,0 +1,120 @@
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "../map.hpp"
+#include "../rcu_map.hpp"
+#include "../pair.hpp"
+
+/* Read scaling under one writer: 1 to 64 reader threads share a fixed
+ * number of lookups into a 1M-key map while a writer keeps assigning
+ * random keys. ft::rcu_map readers take no lock; the baseline wraps the
+ * default ft::map in a mutex held by every lookup and write. */
+
+const int size = 1 << 20;
+const long lookups = 1 << 20;
+
+typedef std::chrono::steady_clock steady;
+
+double seconds(steady::time_point start) {
+    return std::chrono::duration<double>(steady::now() - start).count();
+}
+
+unsigned next(unsigned& state) {
+    state = state * 1103515245u + 12345u;
+    return (state >> 8);
+}
+
+struct locked_map {
+    ft::map<int, int> map;
+    std::mutex lock;
+
+    struct reader {
+        explicit reader(locked_map& self) : self(self) {
+        }
+
+        bool find(int key, int& value) {
+            std::lock_guard<std::mutex> guard(self.lock);
+            ft::map<int, int>::const_iterator it = self.map.find(key);
+            if (it == self.map.end()) {
+                return (false);
+            }
+            value = it->second;
+            return (true);
+        }
+
+        locked_map& self;
+    };
+
+    void fill() {
+        for (int i = 0; i < size; ++i) {
+            map.insert(ft::make_pair(i * 2, i));
+        }
+    }
+
+    void insert_or_assign(int key, int value) {
+        std::lock_guard<std::mutex> guard(lock);
+        map.insert_or_assign(key, value);
+    }
+};
+
+struct shared_map : ft::rcu_map<int, int> {
+    void fill() {
+        for (int i = 0; i < size; ++i) {
+            edit().insert(ft::make_pair(i * 2, i));
+        }
+        publish();
+    }
+};
+
+template<class Map>
+void run(const char* name, int threads) {
+    Map map;
+    map.fill();
+    volatile bool done = false;
+    long writes = 0;
+    std::thread writer([&] {
+        unsigned state = 7;
+        while (!__atomic_load_n(&done, __ATOMIC_ACQUIRE)) {
+            map.insert_or_assign(next(state) % (size * 2), (int)writes);
+            ++writes;
+        }
+    });
+    std::vector<std::thread> readers;
+    std::vector<long> found(threads);
+    steady::time_point start = steady::now();
+    for (int t = 0; t < threads; ++t) {
+        readers.push_back(std::thread([&, t] {
+            typename Map::reader reader(map);
+            unsigned state = t + 1;
+            int value;
+            long hits = 0;
+            for (long i = 0; i < lookups / threads; ++i) {
+                hits += reader.find(next(state) % (size * 2), value);
+            }
+            found[t] = hits;
+        }));
+    }
+    for (int t = 0; t < threads; ++t) {
+        readers[t].join();
+    }
+    double elapsed = seconds(start);
+    __atomic_store_n(&done, true, __ATOMIC_RELEASE);
+    writer.join();
+    long total = 0;
+    for (int t = 0; t < threads; ++t) {
+        total += found[t];
+    }
+    std::cout << name << "\t" << threads << " readers\t" << lookups / elapsed / 1e6 << " M lookups/s, "
+              << writes / elapsed << " writes/s\t" << total << std::endl;
+}
+
+int main() {
+    for (int threads = 1; threads <= 64; threads *= 2) {
+        run<locked_map>("mutex", threads);
+        run<shared_map>("rcu", threads);
+    }
+}
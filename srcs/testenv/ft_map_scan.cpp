@@ -0,0 +1,42 @@
+#include <ctime>
+#include <iostream>
+
+#include "../map.hpp"
+#include "../pair.hpp"
+
+using namespace ft;
+
+/* Full forward and reverse scans over keys inserted in random order */
+template<class Map>
+void run(const char* name, size_t size, int rounds) {
+    Map data;
+    srand(1);
+    for (size_t i = 0; i < size; ++i) {
+        data.insert(make_pair(rand(), (int)i));
+    }
+
+    long sum = 0;
+    clock_t start = clock();
+    for (int i = 0; i < rounds; ++i) {
+        for (typename Map::const_iterator it = data.begin(); it != data.end(); ++it) {
+            sum += it->second;
+        }
+    }
+    double forward = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+    start = clock();
+    for (int i = 0; i < rounds; ++i) {
+        for (typename Map::const_reverse_iterator it = data.rbegin(); it != data.rend(); ++it) {
+            sum -= it->second;
+        }
+    }
+    double reverse = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+    std::cout << name << ": forward " << forward * 1e9 / (rounds * data.size()) << " ns/element, reverse "
+              << reverse * 1e9 / (rounds * data.size()) << " ns/element, " << sum << std::endl;
+}
+
+int main() {
+    run<map<int, int> >("treap_tree", 1000000, 20);
+    run<map<int, int, std::less<int>, std::allocator<pair<const int, int> >, threaded_tree> >("threaded_tree", 1000000, 20);
+}
@@ -0,0 +1,64 @@
+#include <cstdlib>
+#include <ctime>
+#include <iostream>
+
+#include "../map.hpp"
+#include "../pair.hpp"
+
+using namespace ft;
+
+/* Snapshots of a large map taken between batches of writes: deep copies
+ * of the default tree against O(1) copies of the persistent one, which
+ * then pay for path copying on the writes that follow. Each snapshot is
+ * read through once, as an export would. */
+
+const int size = 1000000;
+const int snapshots = 20;
+const int writes = 10000;
+
+double elapsed(clock_t start) {
+    return (double)(clock() - start) * 1e3 / CLOCKS_PER_SEC;
+}
+
+template<class Map>
+void run(const char* name) {
+    Map live;
+    for (int i = 0; i < size; ++i) {
+        live.insert(ft::make_pair(rand() % (size * 4), i));
+    }
+    double copy = 0;
+    double write = 0;
+    double scan = 0;
+    long sum = 0;
+    for (int round = 0; round < snapshots; ++round) {
+        clock_t start = clock();
+        Map snapshot(live);
+        copy += elapsed(start);
+
+        start = clock();
+        for (int i = 0; i < writes; ++i) {
+            int key = rand() % (size * 4);
+            if (i % 2) {
+                live[key] = i;
+            } else {
+                live.erase(key);
+            }
+        }
+        write += elapsed(start);
+
+        start = clock();
+        const Map& view = snapshot;
+        for (typename Map::const_iterator it = view.begin(); it != view.end(); ++it) {
+            sum += it->second;
+        }
+        scan += elapsed(start);
+    }
+    std::cout << name << "\tcopy " << copy / snapshots << " ms, " << writes << " writes " << write / snapshots
+              << " ms, scan " << scan / snapshots << " ms per snapshot\t" << sum << std::endl;
+}
+
+int main() {
+    srand(1);
+    run<map<int, int> >("deep copy");
+    run<map<int, int, std::less<int>, std::allocator<pair<const int, int> >, persistent_tree> >("persistent");
+}
@@ -0,0 +1,43 @@
+#include <ctime>
+#include <iostream>
+
+#include "../map.hpp"
+#include "../pair.hpp"
+
+using namespace ft;
+
+/* Re-sharding: cut a map at a random key and put it back together */
+template<class Map>
+void run(const char* name, size_t size, int rounds) {
+    Map data;
+    for (size_t i = 0; i < size; ++i) {
+        data.insert(data.end(), make_pair((int)i, (int)i));
+    }
+
+    clock_t start = clock();
+    srand(1);
+    for (int i = 0; i < rounds; ++i) {
+        Map shard;
+        data.split(rand() % (int)size, shard);
+        data.join(shard);
+    }
+    double split = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+    start = clock();
+    srand(1);
+    for (int i = 0; i < rounds / 100; ++i) {
+        typename Map::iterator first = data.lower_bound(rand() % (int)size);
+        Map shard(first, data.end());
+        data.erase(first, data.end());
+        data.insert(shard.begin(), shard.end());
+    }
+    double copy = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+    std::cout << name << ": split + join " << (long)(split * 1e9 / rounds) << " ns, copy + insert "
+              << (long)(copy * 1e9 / (rounds / 100)) << " ns, " << data.size() << " elements" << std::endl;
+}
+
+int main() {
+    run<map<int, int> >("treap_tree", 1000000, 10000);
+    run<map<int, int, std::less<int>, std::allocator<pair<const int, int> >, order_statistic_tree> >("order_statistic_tree", 1000000, 10000);
+}
@@ -0,0 +1,57 @@
+#include <ctime>
+#include <iostream>
+#include <string>
+
+#include "../map.hpp"
+#include "../pair.hpp"
+
+using namespace ft;
+
+typedef map<int, std::string> Map;
+
+/* Moving elements between maps: node handles against copying out and erasing */
+int main() {
+    const int size = 200000;
+    const int rounds = 1000000;
+    const std::string payload(64, 'x');
+    Map from;
+    Map to;
+    for (int i = 0; i < size; ++i) {
+        from.insert(ft::make_pair(i, payload));
+    }
+
+    clock_t start = clock();
+    srand(1);
+    for (int i = 0; i < rounds; ++i) {
+        int key = rand() % size;
+        Map& source = (from.count(key) ? from : to);
+        Map& target = (&source == &from ? to : from);
+        target.insert(source.extract(key));
+    }
+    double handles = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+    start = clock();
+    srand(1);
+    for (int i = 0; i < rounds; ++i) {
+        int key = rand() % size;
+        Map& source = (from.count(key) ? from : to);
+        Map& target = (&source == &from ? to : from);
+        Map::iterator it = source.find(key);
+        target.insert(*it);
+        source.erase(it);
+    }
+    double copies = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+    Map odd;
+    Map even;
+    for (int i = 0; i < size; ++i) {
+        (i % 2 ? odd : even).insert(ft::make_pair(i, payload));
+    }
+    start = clock();
+    odd.merge(even);
+    double merge = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+    std::cout << "extract + insert " << (long)(handles * 1e9 / rounds) << " ns, find + insert + erase "
+              << (long)(copies * 1e9 / rounds) << " ns, interleaved merge of " << size << " elements "
+              << (long)(merge * 1e3) << " ms, " << from.size() + to.size() << " " << odd.size() << " " << even.size() << std::endl;
+}
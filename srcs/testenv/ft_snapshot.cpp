@@ -0,0 +1,105 @@
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sys/time.h>
+
+#include "../map.hpp"
+#include "../vector.hpp"
+#include "../frozen_map.hpp"
+#include "../snapshot.hpp"
+#include "../pair.hpp"
+
+using namespace ft;
+
+/* Restart: a 4M-key map and a 32M-element vector written out and read
+ * back, as a text dump rebuilt through insert and push_back against
+ * binary snapshots. The snapshot map is loaded into ft::map in O(n), or
+ * viewed in place as a frozen_map: then the first lookups are the only
+ * reads. Wall time, with the files in the page cache. */
+
+const long size = 1 << 22;
+const long elements = 1 << 25;
+const int lookups = 1000;
+
+double now() {
+    struct timeval tv;
+    gettimeofday(&tv, nullptr);
+    return (tv.tv_sec * 1e3 + tv.tv_usec / 1e3);
+}
+
+void report(const char* name, double start, long check) {
+    std::cout << name << "\t" << (long)(now() - start) << " ms\t" << check << std::endl;
+}
+
+int main() {
+    map<long, long> data;
+    for (long i = 0; i < size; ++i) {
+        data.insert(make_pair(i * 3, i));
+    }
+    vector<long> array;
+    for (long i = 0; i < elements; ++i) {
+        array.push_back(i ^ 0x5555);
+    }
+
+    double start = now();
+    {
+        std::ofstream out("map.txt");
+        for (map<long, long>::iterator it = data.begin(); it != data.end(); ++it) {
+            out << it->first << ' ' << it->second << '\n';
+        }
+        std::ofstream other("vector.txt");
+        for (long i = 0; i < elements; ++i) {
+            other << array[i] << '\n';
+        }
+    }
+    report("text save", start, 0);
+    start = now();
+    {
+        map<long, long> loaded;
+        vector<long> numbers;
+        std::ifstream in("map.txt");
+        long key;
+        long value;
+        while (in >> key >> value) {
+            loaded.insert(make_pair(key, value));
+        }
+        std::ifstream other("vector.txt");
+        while (other >> value) {
+            numbers.push_back(value);
+        }
+        report("text load", start, loaded.size() + numbers.size());
+    }
+
+    start = now();
+    save("map.snap", data);
+    save("vector.snap", array);
+    frozen_map<long, long> frozen(data.begin(), data.end());
+    save("frozen.snap", frozen);
+    report("snapshot save", start, 0);
+    start = now();
+    {
+        map<long, long> loaded;
+        vector<long> numbers;
+        load("map.snap", loaded);
+        load("vector.snap", numbers);
+        report("snapshot load", start, loaded.size() + numbers.size());
+    }
+    start = now();
+    {
+        snapshot file("frozen.snap");
+        frozen_map<long, long> mapped;
+        view(file, mapped);
+        long found = 0;
+        for (int i = 0; i < lookups; ++i) {
+            found += mapped.count(rand() % (size * 3));
+        }
+        report("snapshot view", start, mapped.size() + found);
+    }
+
+    std::remove("map.txt");
+    std::remove("vector.txt");
+    std::remove("map.snap");
+    std::remove("vector.snap");
+    std::remove("frozen.snap");
+}
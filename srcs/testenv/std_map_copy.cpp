@@ -0,0 +1,27 @@
+#include <map>
+#include <ctime>
+#include <iostream>
+
+#include "../map.hpp"
+#include "../pair.hpp"
+
+using namespace std;
+
+int main() {
+    map<int, int> data;
+    size_t testSize = 1000000;
+
+    srand(testSize);
+    for (size_t i = 0; i < testSize; ++i) {
+        data.insert(make_pair(rand(), i));
+    }
+
+    clock_t start = clock();
+    for (size_t i = 0; i < 10; ++i) {
+        map<int, int> copy(data);
+        map<int, int> assigned;
+        assigned = copy;
+    }
+    std::cout << "20 copies of " << data.size() << " elements: "
+              << (double)(clock() - start) / CLOCKS_PER_SEC << "s" << std::endl;
+}
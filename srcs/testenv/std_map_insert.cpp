@@ -0,0 +1,48 @@
+#include <map>
+#include <iostream>
+
+#include "../map.hpp"
+#include "../pair.hpp"
+
+using namespace std;
+
+static size_t comparisons = 0;
+
+struct counting_less {
+    bool operator()(int lhs, int rhs) const {
+        ++comparisons;
+        return lhs < rhs;
+    }
+};
+
+int main() {
+    map<int, int, counting_less> data;
+    size_t testSize = 100000;
+
+    for (size_t i = 0; i < testSize; ++i) {
+        srand(i);
+        int value = rand() % testSize + 1;
+        data.insert(make_pair(value, i));
+    }
+    std::cout << "insert: " << (double)comparisons / testSize << " comparisons per call" << std::endl;
+
+    comparisons = 0;
+    for (size_t i = 0; i < testSize; ++i) {
+        srand(i + testSize);
+        int value = rand() % (2 * testSize) + 1;
+        data[value] = i;
+    }
+    std::cout << "operator[]: " << (double)comparisons / testSize << " comparisons per call" << std::endl;
+
+    map<int, int, counting_less> sorted;
+    comparisons = 0;
+    for (size_t i = 0; i < testSize; ++i) {
+        sorted.insert(sorted.end(), make_pair((int)i, (int)i));
+    }
+    std::cout << "sorted insert(end(), value): " << (double)comparisons / testSize << " comparisons per call" << std::endl;
+
+    map<int, int, counting_less> copy;
+    comparisons = 0;
+    copy.insert(sorted.begin(), sorted.end());
+    std::cout << "sorted insert(first, last): " << (double)comparisons / testSize << " comparisons per element" << std::endl;
+}
@@ -0,0 +1,70 @@
+#include <map>
+#include <ctime>
+#include <memory>
+#include <iostream>
+
+#include "../map.hpp"
+#include "../pair.hpp"
+
+using namespace std;
+
+/* Stateful allocator: keeps the number of bytes it currently hands out */
+template<class T>
+struct byte_counting_allocator : public std::allocator<T> {
+    template<class U>
+    struct rebind {
+        typedef byte_counting_allocator<U> other;
+    };
+
+    size_t* bytes;
+
+    explicit byte_counting_allocator(size_t* bytes) : bytes(bytes) {
+    }
+
+    template<class U>
+    byte_counting_allocator(const byte_counting_allocator<U>& other) : std::allocator<T>(other), bytes(other.bytes) {
+    }
+
+    T* allocate(size_t n, const void* = 0) {
+        *bytes += n * sizeof(T);
+        return std::allocator<T>::allocate(n);
+    }
+
+    void deallocate(T* p, size_t n) {
+        *bytes -= n * sizeof(T);
+        std::allocator<T>::deallocate(p, n);
+    }
+};
+
+int main() {
+    typedef byte_counting_allocator<pair<const int, int> > allocator;
+    size_t bytes = 0;
+    size_t testSize = 2000000;
+    std::less<int> compare;
+    map<int, int, std::less<int>, allocator> data(compare, allocator(&bytes));
+
+    srand(1);
+    for (size_t i = 0; i < testSize; ++i) {
+        data.insert(make_pair(rand(), (int)i));
+    }
+
+    clock_t start = clock();
+    size_t found = 0;
+    for (size_t i = 0; i < 4 * testSize; ++i) {
+        found += data.count(rand());
+    }
+    double seconds = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+    start = clock();
+    long sum = 0;
+    for (size_t i = 0; i < testSize / 8; ++i) {
+        map<int, int, std::less<int>, allocator>::iterator it = data.lower_bound(rand());
+        for (int j = 0; j < 64 && it != data.end(); ++j, ++it) {
+            sum += it->second;
+        }
+    }
+    double scan = (double)(clock() - start) / CLOCKS_PER_SEC;
+    std::cout << "std::map: " << (double)bytes / data.size() << " bytes/element, "
+              << seconds * 1e9 / (4 * testSize) << " ns/lookup, "
+              << scan * 1e9 / (testSize / 8) << " ns/64-element scan, " << found + sum % 2 << " hits" << std::endl;
+}
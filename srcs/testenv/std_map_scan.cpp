@@ -0,0 +1,37 @@
+#include <cstdlib>
+#include <map>
+#include <ctime>
+#include <iostream>
+
+using namespace std;
+
+/* Full forward and reverse scans over keys inserted in random order */
+int main() {
+    size_t size = 1000000;
+    int rounds = 20;
+    map<int, int> data;
+    srand(1);
+    for (size_t i = 0; i < size; ++i) {
+        data.insert(make_pair(rand(), (int)i));
+    }
+
+    long sum = 0;
+    clock_t start = clock();
+    for (int i = 0; i < rounds; ++i) {
+        for (map<int, int>::const_iterator it = data.begin(); it != data.end(); ++it) {
+            sum += it->second;
+        }
+    }
+    double forward = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+    start = clock();
+    for (int i = 0; i < rounds; ++i) {
+        for (map<int, int>::const_reverse_iterator it = data.rbegin(); it != data.rend(); ++it) {
+            sum -= it->second;
+        }
+    }
+    double reverse = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+    std::cout << "std::map: forward " << forward * 1e9 / (rounds * data.size()) << " ns/element, reverse "
+              << reverse * 1e9 / (rounds * data.size()) << " ns/element, " << sum << std::endl;
+}
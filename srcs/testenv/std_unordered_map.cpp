@@ -0,0 +1,99 @@
+#include <cstdlib>
+#include <ctime>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <unordered_map>
+
+using namespace std;
+
+/* Insert, hit, miss and erase costs per element for int and string keys,
+ * at sizes from 1K to 1M; other sizes come from the command line, e.g.
+ * ./app 10000000 100000000 */
+
+const size_t lookups = 2000000;
+
+double elapsed(clock_t start, size_t count) {
+    return (double)(clock() - start) * 1e9 / CLOCKS_PER_SEC / count;
+}
+
+void make_keys(std::vector<int>& keys, size_t size, unsigned salt) {
+    keys.resize(size);
+    for (size_t i = 0; i < size; ++i) {
+        keys[i] = (int)((unsigned)(i * 2 + salt) * 2654435761U);
+    }
+}
+
+void make_keys(std::vector<std::string>& keys, size_t size, unsigned salt) {
+    std::vector<int> ints;
+    make_keys(ints, size, salt);
+    keys.resize(size);
+    for (size_t i = 0; i < size; ++i) {
+        std::ostringstream key;
+        key << "user:" << ints[i];
+        keys[i] = key.str();
+    }
+}
+
+template<class Map, class Key>
+void run(const char* name, const char* type, const std::vector<Key>& keys, const std::vector<Key>& misses) {
+    size_t size = keys.size();
+    Map data;
+    clock_t start = clock();
+    for (size_t i = 0; i < size; ++i) {
+        data.insert(std::make_pair(keys[i], (int)i));
+    }
+    double insert = elapsed(start, size);
+
+    long sum = 0;
+    start = clock();
+    for (size_t i = 0; i < lookups; ++i) {
+        typename Map::iterator it = data.find(keys[(i * 7919) % size]);
+        if (it != data.end()) {
+            sum += it->second;
+        }
+    }
+    double hit = elapsed(start, lookups);
+
+    start = clock();
+    for (size_t i = 0; i < lookups; ++i) {
+        sum += data.count(misses[(i * 7919) % size]);
+    }
+    double miss = elapsed(start, lookups);
+
+    start = clock();
+    for (size_t i = 0; i < size; ++i) {
+        data.erase(keys[i]);
+    }
+    double erase = elapsed(start, size);
+
+    std::cout << type << "\t" << size << "\t" << name << "\tinsert " << (long)insert << " ns, hit " << (long)hit
+              << " ns, miss " << (long)miss << " ns, erase " << (long)erase << " ns\t" << sum << std::endl;
+}
+
+template<class Key>
+void compare(const char* type, size_t size) {
+    std::vector<Key> keys;
+    std::vector<Key> misses;
+    make_keys(keys, size, 0);
+    make_keys(misses, size, 1);
+    run<unordered_map<Key, int> >("std::unordered_map", type, keys, misses);
+}
+
+int main(int argc, char** argv) {
+    std::vector<size_t> sizes;
+    for (int i = 1; i < argc; ++i) {
+        sizes.push_back(std::strtoul(argv[i], NULL, 10));
+    }
+    if (sizes.empty()) {
+        for (size_t size = 1000; size <= 1000000; size *= 10) {
+            sizes.push_back(size);
+        }
+    }
+    for (size_t i = 0; i < sizes.size(); ++i) {
+        compare<int>("int", sizes[i]);
+        compare<std::string>("string", sizes[i]);
+    }
+}
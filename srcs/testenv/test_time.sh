@@ -19,5 +19,140 @@ g++ -Wall -Wextra -Werror -std=c++98 std_map.cpp -o app
 time ./app
 echo
 
+echo "FT MAP INSERT"
+g++ -Wall -Wextra -Werror -std=c++98 ft_map_insert.cpp -o app
+time ./app
+echo
+
+echo "STD MAP INSERT"
+g++ -Wall -Wextra -Werror -std=c++98 std_map_insert.cpp -o app
+time ./app
+echo
+
+echo "FT MAP COPY"
+g++ -Wall -Wextra -Werror -std=c++98 ft_map_copy.cpp -o app
+time ./app
+echo
+
+echo "STD MAP COPY"
+g++ -Wall -Wextra -Werror -std=c++98 std_map_copy.cpp -o app
+time ./app
+echo
+
+echo "FT MAP LOOKUP"
+g++ -Wall -Wextra -Werror -std=c++98 ft_map_lookup.cpp -o app
+time ./app
+echo
+
+echo "STD MAP LOOKUP"
+g++ -Wall -Wextra -Werror -std=c++98 std_map_lookup.cpp -o app
+time ./app
+echo
+
+echo "FT MAP ALLOC"
+g++ -Wall -Wextra -Werror -std=c++98 ft_map_alloc.cpp -o app
+time ./app
+echo
+
+echo "STD MAP ALLOC"
+g++ -Wall -Wextra -Werror -std=c++98 std_map_alloc.cpp -o app
+time ./app
+echo
+
+echo "FT MAP LAYOUT"
+g++ -Wall -Wextra -Werror -std=c++98 ft_map_layout.cpp -o app
+time ./app
+echo
+
+echo "STD MAP LAYOUT"
+g++ -Wall -Wextra -Werror -std=c++98 std_map_layout.cpp -o app
+time ./app
+echo
+
+echo "FT FLAT MAP"
+g++ -Wall -Wextra -Werror -std=c++98 ft_flat_map.cpp -o app
+time ./app
+echo
+
+echo "FT FLAT MAP READ"
+g++ -Wall -Wextra -Werror -std=c++98 ft_flat_map_read.cpp -o app
+time ./app
+echo
+
+echo "FT MAP SPLIT"
+g++ -Wall -Wextra -Werror -std=c++98 ft_map_split.cpp -o app
+time ./app
+echo
+
+echo "FT MAP SCAN"
+g++ -Wall -Wextra -Werror -std=c++98 ft_map_scan.cpp -o app
+time ./app
+echo
+
+echo "STD MAP SCAN"
+g++ -Wall -Wextra -Werror -std=c++98 std_map_scan.cpp -o app
+time ./app
+echo
+
+echo "FT MAP TRANSFER"
+g++ -Wall -Wextra -Werror -std=c++98 ft_map_transfer.cpp -o app
+time ./app
+echo
+
+echo "FT MAP BALANCE"
+g++ -Wall -Wextra -Werror -std=c++98 ft_map_balance.cpp -o app
+time ./app
+echo
+
+echo "FT UNORDERED MAP"
+g++ -Wall -Wextra -Werror -std=c++98 ft_unordered_map.cpp -o app
+time ./app
+echo
+
+echo "STD UNORDERED MAP"
+g++ -Wall -Wextra -Werror -std=c++11 std_unordered_map.cpp -o app
+time ./app
+echo
+
+echo "FT MAP BATCH"
+g++ -Wall -Wextra -Werror -std=c++98 ft_map_batch.cpp -o app
+time ./app
+echo
+
+echo "FT MAP AGGREGATE"
+g++ -Wall -Wextra -Werror -std=c++98 ft_map_aggregate.cpp -o app
+time ./app
+echo
+
+echo "FT MAP SNAPSHOT"
+g++ -Wall -Wextra -Werror -std=c++98 ft_map_snapshot.cpp -o app
+time ./app
+echo
+
+echo "FT MAP RCU"
+g++ -Wall -Wextra -Werror -Wno-deprecated-copy -std=c++11 -pthread ft_map_rcu.cpp -o app
+time ./app
+echo
+
+echo "FT CONCURRENT MAP"
+g++ -Wall -Wextra -Werror -Wno-deprecated-copy -std=c++11 -pthread ft_concurrent_map.cpp -o app
+time ./app
+echo
+
+echo "FT MAP FINGER"
+g++ -Wall -Wextra -Werror -std=c++98 ft_map_finger.cpp -o app
+time ./app
+echo
+
+echo "FT FROZEN MAP"
+g++ -Wall -Wextra -Werror -std=c++98 ft_frozen_map.cpp -o app
+time ./app
+echo
+
+echo "FT SNAPSHOT"
+g++ -Wall -Wextra -Werror -std=c++98 ft_snapshot.cpp -o app
+time ./app
+echo
+
 ./app
 rm -rf app
@@ -8,6 +8,8 @@
 #include "iterators_traits.hpp"
 #include "algorithm.hpp"
 #include "pair.hpp"
+#include "vector.hpp"
+#include "node_pool.hpp"
 
 namespace ft {
 
@@ -18,21 +20,254 @@ namespace ft {
         none
     };
 
+    /* Node augmentations: extra data kept in every node, recomputed from
+     * the children whenever the shape below a node changes */
+    struct no_augment {
+        enum { enabled = 0 };
+
+        struct node_data {
+        };
+
+        template<class Node>
+        static void update(Node*) {
+        }
+    };
+
+    /* Subtree sizes, for order statistics */
+    struct size_augment {
+        enum { enabled = 1 };
+
+        struct node_data {
+            size_t size;
+        };
+
+        template<class Node>
+        static void update(Node* pnode) {
+            pnode->size = 1 + (pnode->left ? pnode->left->size : 0) + (pnode->right ? pnode->right->size : 0);
+        }
+    };
+
+    /* In-order neighbour links, so that iterators step with one load. They
+     * do not derive from the children: the Treap keeps them on insert and
+     * erase, and the header closes the ring. */
+    struct thread_augment {
+        enum { enabled = 0 };
+
+        struct node_data {
+            node_data* prev;
+            node_data* next;
+        };
+
+        template<class Node>
+        static void update(Node*) {
+        }
+    };
+
+    /* Finger search. Nothing in the nodes: the Treap remembers the node its
+     * last lookup reached, and starts the next one from the lowest ancestor
+     * of it whose subtree holds the key, climbing through parent links. A
+     * key d elements away from the previous one is mostly found in about
+     * log d steps up and down instead of the whole height; only neighbours
+     * on both sides of a high node climb up to it. Const lookups move the
+     * finger too, so a tree with it must not be read from several threads
+     * at once. */
+    struct finger_augment {
+        enum { enabled = 0 };
+
+        struct node_data {
+        };
+
+        template<class Node>
+        static void update(Node*) {
+        }
+    };
+
+    /* Two augmentations in one node */
+    template<class First, class Second>
+    struct augment_pair {
+        enum { enabled = First::enabled || Second::enabled };
+
+        struct node_data : public First::node_data, public Second::node_data {
+        };
+
+        template<class Node>
+        static void update(Node* pnode) {
+            First::update(pnode);
+            Second::update(pnode);
+        }
+    };
+
+    /* Aggregate of every subtree under a monoid, for range aggregates.
+     * Monoid gives the aggregate type, its identity, an associative
+     * combine() and lift(), the aggregate of one element:
+     *
+     *     struct total_bytes {
+     *         typedef long value_type;
+     *         static long identity() { return 0; }
+     *         static long combine(long lhs, long rhs) { return lhs + rhs; }
+     *         static long lift(const ft::pair<const int, Packet>& element) { return element.second.bytes; }
+     *     };
+     *
+     * combine() need not be commutative: operands always come in key order. */
+    template<class Monoid>
+    struct monoid_augment {
+        enum { enabled = 1 };
+
+        struct node_data {
+            typename Monoid::value_type aggregate;
+        };
+
+        template<class Node>
+        static void update(Node* pnode) {
+            typename Monoid::value_type aggregate = Monoid::lift(pnode->value);
+            if (pnode->left) {
+                aggregate = Monoid::combine(pnode->left->aggregate, aggregate);
+            }
+            if (pnode->right) {
+                aggregate = Monoid::combine(aggregate, pnode->right->aggregate);
+            }
+            pnode->aggregate = aggregate;
+        }
+    };
+
+    /* The monoid of an augmentation and its aggregate type, void without one */
+    template<class Augment>
+    struct augment_aggregate {
+        typedef void monoid_type;
+        typedef void type;
+    };
+
+    template<class Monoid>
+    struct augment_aggregate<monoid_augment<Monoid> > {
+        typedef Monoid monoid_type;
+        typedef typename Monoid::value_type type;
+    };
+
+    template<class First, class Second>
+    struct augment_aggregate<augment_pair<First, Second> > : public augment_aggregate<Second> {
+    };
+
+    template<class Monoid, class Second>
+    struct augment_aggregate<augment_pair<monoid_augment<Monoid>, Second> > : public augment_aggregate<monoid_augment<Monoid> > {
+    };
+
+    /* Monoids over the mapped values of a map */
+    template<class T>
+    struct mapped_sum {
+        typedef T value_type;
+
+        static T identity() {
+            return T();
+        }
+
+        static T combine(const T& lhs, const T& rhs) {
+            return lhs + rhs;
+        }
+
+        template<class Pair>
+        static T lift(const Pair& element) {
+            return element.second;
+        }
+    };
+
+    template<class T>
+    struct mapped_min {
+        typedef T value_type;
+
+        static T identity() {
+            return std::numeric_limits<T>::max();
+        }
+
+        static T combine(const T& lhs, const T& rhs) {
+            return (rhs < lhs ? rhs : lhs);
+        }
+
+        template<class Pair>
+        static T lift(const Pair& element) {
+            return element.second;
+        }
+    };
+
+    template<class T>
+    struct mapped_max {
+        typedef T value_type;
+
+        static T identity() {
+            return (std::numeric_limits<T>::is_integer ? std::numeric_limits<T>::min() : -std::numeric_limits<T>::max());
+        }
+
+        static T combine(const T& lhs, const T& rhs) {
+            return (lhs < rhs ? rhs : lhs);
+        }
+
+        template<class Pair>
+        static T lift(const Pair& element) {
+            return element.second;
+        }
+    };
+
+    /* Two monoids at once, their aggregates in a ft::pair */
+    template<class First, class Second>
+    struct monoid_pair {
+        typedef ft::pair<typename First::value_type, typename Second::value_type> value_type;
+
+        static value_type identity() {
+            return value_type(First::identity(), Second::identity());
+        }
+
+        static value_type combine(const value_type& lhs, const value_type& rhs) {
+            return value_type(First::combine(lhs.first, rhs.first), Second::combine(lhs.second, rhs.second));
+        }
+
+        template<class Element>
+        static value_type lift(const Element& element) {
+            return value_type(First::lift(element), Second::lift(element));
+        }
+    };
+
+    /* Balancing policies: how the Treap keeps its shape. Every node has one
+     * word for the policy, its height, color or priority. */
+
+    /* Heights of siblings differ by one at most: the shallowest tree, the
+     * most rotations on writes */
+    struct avl_balance {
+    };
+
+    /* Red and black nodes, at most two rotations per insert and three per
+     * erase; up to twice as deep as a perfect tree */
+    struct red_black_balance {
+        enum {
+            black = 0,
+            red = 1
+        };
+    };
+
+    /* A treap proper: nodes are heap ordered by a random priority, the
+     * expected depth is logarithmic whatever the order of the keys */
+    struct treap_balance {
+    };
+
+    /* Splay tree: every insert and every lookup of a non-const tree rotates
+     * the node it reaches to the root, so hot keys stay near the top.
+     * Costs are amortized logarithmic. */
+    struct splay_balance {
+    };
+
     /* Treap node */
-    template<class U>
-    struct _node {
+    template<class U, class Data = no_augment::node_data>
+    struct _node : public Data {
         typedef U value_type;
 
         value_type value;
         size_t height;
-        _node<value_type>* left;
-        _node<value_type>* right;
-        _node<value_type>* parent;
+        _node* left;
+        _node* right;
+        _node* parent;
 
-        explicit _node(const value_type& value)  : value(value), height(1), left(nullptr), right(nullptr), parent(nullptr) {
+        explicit _node(const value_type& value)  : Data(), value(value), height(1), left(nullptr), right(nullptr), parent(nullptr) {
         }
 
-        _node(const _node& other) : value(other.value), height(1), left(other.left), right(other.right), parent(other.parent) {
+        _node(const _node& other) : Data(other), value(other.value), height(1), left(other.left), right(other.right), parent(other.parent) {
         }
 
         _node& operator=(const _node& other) {
@@ -50,16 +285,23 @@ namespace ft {
 
     };
 
-    /* Treap iterator */
-    template<typename T>
+    /* Marks the mutable iterator of a tree whose values are read-only */
+    struct read_only_tag {
+    };
+
+    /* Treap iterator. The mutable iterator of a tree keeping aggregates of
+     * its values is TreapIter<const Value, Node, read_only_tag>: it only
+     * reads, as a write in place would leave the aggregates stale, but is a
+     * type of its own beside the const_iterator. */
+    template<typename T, class Node = _node<typename ft::iterator_traits<T*>::value_type>, class Tag = void>
     class TreapIter : iterator<T, ft::bidirectional_iterator_tag>{
     public:
         typedef ft::bidirectional_iterator_tag iterator_category;
         typedef typename ft::iterator_traits<T*>::value_type 		value_type;
-		typedef typename ft::iterator_traits<T*>::pointer			pointer;
-		typedef typename ft::iterator_traits<T*>::reference 		reference;
+		typedef T*			pointer;
+		typedef T& 		reference;
 		typedef typename ft::iterator_traits<T*>::difference_type	difference_type;
-		typedef _node<value_type>* node_pointer;
+		typedef Node* node_pointer;
 
     public:
         TreapIter() {
@@ -74,6 +316,12 @@ namespace ft {
             _pnode = other._pnode;
         }
 
+        /* iterator to const_iterator */
+        template<class U, class G>
+        TreapIter(const TreapIter<U, Node, G>& other) {
+            _pnode = other.base();
+        }
+
         TreapIter& operator=(const TreapIter& other) {
             if (this != &other) {
                 _pnode = other._pnode;
@@ -95,111 +343,186 @@ namespace ft {
         }
 
         TreapIter& operator++() {
-            if (_pnode->right) {
-                _pnode = _treap_subtree_min(_pnode->right);
-            } else {
-                node_pointer parent = _pnode->parent;
-                while (parent && parent->right == _pnode) {
-                    _pnode = parent;
-                    parent = _pnode->parent;
-                }
-                if (parent) {
-                    _pnode = parent;
-                }
-            }
+            _pnode = _next(_pnode, _pnode);
             return *this;
         }
 
         TreapIter operator++(int) {
-            TreapIter<T> temp(*this);
-
-            if (_pnode->right) {
-                _pnode = _treap_subtree_min(_pnode->right);
-            } else {
-                node_pointer parent = _pnode->parent;
-                while (parent && parent->right == _pnode) {
-                    _pnode = parent;
-                    parent = _pnode->parent;
-                }
-                if (parent) {
-                    _pnode = parent;
-                }
-            }
+            TreapIter temp(*this);
+            _pnode = _next(_pnode, _pnode);
             return temp;
         }
 
         TreapIter& operator--() {
-            if (_pnode->left) {
-                _pnode = _treap_subtree_max(_pnode->left);
-            } else {
-                node_pointer parent = _pnode->parent;
-                while(parent && parent->left == _pnode) {
-                    _pnode = parent;
-                    parent = _pnode->parent;
-                }
-                if (parent) {
-                    _pnode = parent;
-                }
-            }
+            _pnode = _prev(_pnode, _pnode);
             return *this;
         }
 
         TreapIter operator--(int) {
-            TreapIter<T> temp(*this);
-            if (_pnode->left) {
-                _pnode = _treap_subtree_max(_pnode->left);
-            } else {
-                node_pointer parent = _pnode->parent;
-                while(parent && parent->left == _pnode) {
-                    _pnode = parent;
-                    parent = _pnode->parent;
-                }
-                if (parent) {
-                    _pnode = parent;
-                }
-            }
+            TreapIter temp(*this);
+            _pnode = _prev(_pnode, _pnode);
             return temp;
         }
 
     private:
-        node_pointer _treap_subtree_max(node_pointer ptreap) const {
-            if (!ptreap->right) {
-                return ptreap;
-            } else {
-                return _treap_subtree_max(ptreap->right);
+        /* Threaded nodes hold their neighbours, others walk the tree */
+        static node_pointer _next(node_pointer pnode, const thread_augment::node_data*) {
+            return static_cast<node_pointer>(pnode->next);
+        }
+
+        static node_pointer _next(node_pointer pnode, const void*) {
+            if (pnode->right) {
+                return _treap_subtree_min(pnode->right);
+            }
+            node_pointer parent = pnode->parent;
+            while (parent && parent->right == pnode) {
+                pnode = parent;
+                parent = pnode->parent;
             }
+            return (parent ? parent : pnode);
         }
 
-        node_pointer _treap_subtree_min(node_pointer ptreap) const {
-            if (!ptreap->left) {
-                return ptreap;
-            } else {
-                return _treap_subtree_min(ptreap->left);
+        static node_pointer _prev(node_pointer pnode, const thread_augment::node_data*) {
+            return static_cast<node_pointer>(pnode->prev);
+        }
+
+        static node_pointer _prev(node_pointer pnode, const void*) {
+            if (pnode->left) {
+                return _treap_subtree_max(pnode->left);
+            }
+            node_pointer parent = pnode->parent;
+            while (parent && parent->left == pnode) {
+                pnode = parent;
+                parent = pnode->parent;
+            }
+            return (parent ? parent : pnode);
+        }
+
+        static node_pointer _treap_subtree_max(node_pointer ptreap) {
+            while (ptreap->right) {
+                ptreap = ptreap->right;
+            }
+            return ptreap;
+        }
+
+        static node_pointer _treap_subtree_min(node_pointer ptreap) {
+            while (ptreap->left) {
+                ptreap = ptreap->left;
             }
+            return ptreap;
         }
 
     private:
         node_pointer _pnode;
     };
 
-    template<class U>
-    bool operator==(const TreapIter<U>& lhs, const TreapIter<U>& rhs) {
+    template<class U, class V, class N, class G, class H>
+    bool operator==(const TreapIter<U, N, G>& lhs, const TreapIter<V, N, H>& rhs) {
         return (lhs.base() == rhs.base());
     }
 
-    template<class U>
-    bool operator!=(const TreapIter<U>& lhs, const TreapIter<U>& rhs) {
+    template<class U, class V, class N, class G, class H>
+    bool operator!=(const TreapIter<U, N, G>& lhs, const TreapIter<V, N, H>& rhs) {
         return (lhs.base() != rhs.base());
     }
 
+    /* Mutable iterator of a tree: read-only when it keeps an aggregate */
+    template<class Value, class Node, class Aggregate>
+    struct treap_iterator {
+        typedef TreapIter<const Value, Node, read_only_tag> type;
+    };
+
+    template<class Value, class Node>
+    struct treap_iterator<Value, Node, void> {
+        typedef TreapIter<Value, Node> type;
+    };
+
+    /* Owning handle to a node taken out of a Treap by extract(). A tree's
+     * insert() links it in without copying or allocating. Copying a handle
+     * hands the node over, as std::auto_ptr does, so handles can be returned
+     * and passed by value; a handle still holding a node destroys it. The
+     * handle holds the node's slab, so it may outlive the tree it came from. */
+    template<class Node, class Pool>
+    class TreapNodeHandle {
+    public:
+        typedef typename Node::value_type value_type;
+        typedef typename Pool::allocator_type allocator_type;
+        typedef Node* node_pointer;
+
+    public:
+        TreapNodeHandle() : _pnode(nullptr), _slab(nullptr), _allocator() {
+        }
+
+        TreapNodeHandle(node_pointer pnode, node_pointer slab, const allocator_type& allocator)
+                : _pnode(pnode), _slab(slab), _allocator(allocator) {
+            Pool::retain_slab(_slab);
+        }
+
+        TreapNodeHandle(const TreapNodeHandle& other) : _pnode(other._pnode), _slab(other._slab), _allocator(other._allocator) {
+            other._pnode = nullptr;
+            other._slab = nullptr;
+        }
+
+        TreapNodeHandle& operator=(const TreapNodeHandle& other) {
+            if (this != &other) {
+                reset();
+                _pnode = other._pnode;
+                _slab = other._slab;
+                _allocator = other._allocator;
+                other._pnode = nullptr;
+                other._slab = nullptr;
+            }
+            return *this;
+        }
+
+        ~TreapNodeHandle() {
+            reset();
+        }
+
+    public:
+        bool empty() const {
+            return (_pnode == nullptr);
+        }
+
+        value_type& value() const {
+            return _pnode->value;
+        }
+
+        allocator_type get_allocator() const {
+            return _allocator;
+        }
+
+        /* Destroys the node, if any */
+        void reset() {
+            if (_pnode) {
+                _allocator.destroy(_pnode);
+                Pool::release_slab(_allocator, _slab);
+                _pnode = nullptr;
+                _slab = nullptr;
+            }
+        }
+
+    private:
+        template<class, class, class, class, class>
+        friend class Treap;
+
+        mutable node_pointer _pnode;
+        mutable node_pointer _slab;
+        allocator_type _allocator;
+    };
+
     /* Treap */
-    template<class Value, class Compare = std::less<Value>, class Alloc = std::allocator<Value> >
+    template<class Value, class Compare = std::less<Value>, class Alloc = std::allocator<Value>,
+            class Augment = ft::no_augment, class Balance = ft::avl_balance>
     class Treap {
     public:
         typedef Value value_type;
         typedef Alloc allocator_type;
         typedef Compare compare_type;
-        typedef _node<Value> node_type;
+        typedef Augment augment_type;
+        typedef Balance balance_type;
+        typedef typename Augment::node_data node_data;
+        typedef _node<Value, node_data> node_type;
 
         typedef typename allocator_type::template rebind<node_type>::other node_allocator;
 
@@ -209,49 +532,51 @@ namespace ft {
         typedef typename node_allocator::const_pointer const_node_pointer;
         typedef typename node_allocator::reference node_reference;
         typedef typename node_allocator::const_reference const_node_reference;
-        typedef TreapIter<value_type> iterator;
-        typedef TreapIter<const value_type> const_iterator;
+        typedef typename augment_aggregate<Augment>::monoid_type monoid_type;
+        typedef typename augment_aggregate<Augment>::type aggregate_type;
+        typedef typename treap_iterator<value_type, node_type, aggregate_type>::type iterator;
+        typedef TreapIter<const value_type, node_type> const_iterator;
         typedef ft::reverse_iterator<iterator> reverse_iterator;
         typedef ft::reverse_iterator<const_iterator> const_reverse_iterator;
+        typedef TreapNodeHandle<node_type, NodePool<node_type, node_allocator> > node_handle;
+
+        /* Place for a new node: child of parent on the given side, or the root if parent is the header */
+        struct slot_type {
+            node_pointer parent;
+            bool left;
+        };
 
     public:
-        Treap(const compare_type& cmp, const allocator_type& allocator = allocator_type()) : _allocator(allocator), _node_allocator(node_allocator()), _cmp(cmp), _size(0) {
+        Treap(const compare_type& cmp, const allocator_type& allocator = allocator_type())
+                : _allocator(allocator), _node_allocator(allocator), _pool(_node_allocator), _cmp(cmp), _size(0), _finger(nullptr) {
             _header = _node_allocator.allocate(1);
             _node_allocator.construct(_header, value_type());
-            _root = _header;
+            _root = _leftmost = _rightmost = _header;
+            _thread_ends();
         }
 
-        Treap(const Treap& other) : _allocator(other._allocator), _node_allocator(other._node_allocator), _cmp(other._cmp), _size(0) {
+        Treap(const Treap& other)
+                : _allocator(other._allocator), _node_allocator(other._node_allocator), _pool(_node_allocator), _cmp(other._cmp), _size(0), _finger(nullptr) {
             if (this != &other) {
                 _header = _node_allocator.allocate(1);
                 _node_allocator.construct(_header, value_type());
-                _root = _header;
-                _insert_all_nodes(_root, other._root);
+                _root = _leftmost = _rightmost = _header;
+                _thread_ends();
+                _clone(other);
             }
         }
 
         Treap& operator=(const Treap& other) {
             if (this != &other) {
-                _allocator = other._allocator;
-                _node_allocator = other._node_allocator;
                 _cmp = other._cmp;
-                _size = 0;
-                if (_root != _header) {
-                    _delete_treap(_root);
-                }
-                _root = _header;
-                _header->left = _header->right = nullptr;
-                if (other._size > 0) {
-                    _insert_all_nodes(_root, other._root);
-                }
+                clear();
+                _clone(other);
             }
             return *this;
         }
 
         ~Treap() {
-            if (_root != _header) {
-                _delete_treap(_root);
-            }
+            clear();
             _node_allocator.destroy(_header);
             _node_allocator.deallocate(_header, 1);
         }
@@ -259,11 +584,11 @@ namespace ft {
     /* iterators */
     public:
         iterator begin() {
-            return iterator(_subtree_min(_root));
+            return iterator(_leftmost);
         }
 
         const_iterator begin() const {
-            return const_iterator(_subtree_min(_root));
+            return const_iterator(_leftmost);
         }
 
         iterator end() {
@@ -298,147 +623,573 @@ namespace ft {
 
     /* Modifiers */
     public:
+        /* Nodes without a destructor to run, for the value or for the
+         * augmentation data, are dropped with their slabs in one go, others
+         * are destroyed first. */
         void clear() {
             if (_root != _header) {
-                _delete_treap(_root);
+                if (!ft::is_trivially_destructible<node_type>::value) {
+                    _delete_treap(_root);
+                }
                 _size = 0;
-                _root = _header;
+                _root = _leftmost = _rightmost = _header;
                 _header->left = _header->right = nullptr;
+                _thread_ends();
             }
+            _finger = nullptr;
+            _pool.release();
         }
 
         ft::pair<iterator, bool> insert(const value_type& value) {
-            node_pointer pnode = nullptr;
-            if (_root != _header) {
-                pnode = _search(_root, value);
-            }
+            slot_type slot;
+            node_pointer pnode = _locate(value, slot);
             if (pnode) {
+                _touch(pnode, _balancing());
                 return ft::make_pair(iterator(pnode), false);
             } else {
-                _insert_avl(value);
-                return ft::make_pair(iterator(_search(_root, value)), true);
+                return ft::make_pair(insert_at(slot, value), true);
+            }
+        }
+
+        /* Finds key in one descent with one comparison per level. Returns
+         * its position, or end() and the slot to pass to insert_at(). Key is
+         * anything compare_type can order against value_type. */
+        template<class K>
+        iterator locate(const K& key, slot_type& slot) {
+            node_pointer pnode = _locate(key, slot);
+            if (pnode) {
+                _touch(pnode, _balancing());
+                return iterator(pnode);
+            }
+            return end();
+        }
+
+        /* Links a new node into a slot returned by locate() and rebalances
+         * upwards. The slot is invalidated by any other modification. */
+        iterator insert_at(const slot_type& slot, const value_type& value) {
+            return _link_at(slot, _create_node(value));
+        }
+
+        /* Replaces the contents with [first, last), keeping the first of equal
+         * values. Sorted input is linked into a balanced tree in O(n), anything
+         * else is sorted first. */
+        template<class InputIt>
+        void assign(InputIt first, InputIt last) {
+            ft::vector<node_pointer> nodes;
+            bool sorted = true;
+            clear();
+            for (; first != last; ++first) {
+                nodes.push_back(_create_node(*first));
+                if (sorted && nodes.size() > 1) {
+                    sorted = _cmp(nodes[nodes.size() - 2]->value, nodes.back()->value);
+                }
+            }
+            size_type count = nodes.size();
+            if (!sorted) {
+                ft::stable_sort(nodes.begin(), nodes.end(), _node_compare(_cmp));
+                count = 1;
+                for (size_type i = 1; i < nodes.size(); ++i) {
+                    if (_cmp(nodes[count - 1]->value, nodes[i]->value)) {
+                        nodes[count++] = nodes[i];
+                    } else {
+                        _delete_node(nodes[i]);
+                    }
+                }
+            }
+            if (count > 0) {
+                _root = _build(nodes.data(), count, _balancing());
+                _assign_paths_header();
+                _leftmost = nodes[0];
+                _rightmost = nodes[count - 1];
+                _size = count;
+                _thread_all();
             }
         }
 
+        /* Links value next to hint without a search when it belongs
+         * right before or right after it, falls back to insert() otherwise. */
         iterator insert(iterator hint, const value_type& value) {
-            (void)hint;
+            node_pointer pos = hint.base();
+            slot_type slot;
+            if (_root == _header) {
+                return insert(value).first;
+            }
+            if (pos == _header) {
+                if (_cmp(_rightmost->value, value)) {
+                    slot.parent = _rightmost;
+                    slot.left = false;
+                    return insert_at(slot, value);
+                }
+            } else if (_cmp(value, pos->value)) {
+                if (pos == _leftmost) {
+                    slot.parent = pos;
+                    slot.left = true;
+                    return insert_at(slot, value);
+                }
+                node_pointer prev = (--hint).base();
+                if (_cmp(prev->value, value)) {
+                    slot.parent = (pos->left ? prev : pos);
+                    slot.left = !pos->left;
+                    return insert_at(slot, value);
+                }
+            } else if (_cmp(pos->value, value)) {
+                if (pos == _rightmost) {
+                    slot.parent = pos;
+                    slot.left = false;
+                    return insert_at(slot, value);
+                }
+                node_pointer next = (++hint).base();
+                if (_cmp(value, next->value)) {
+                    slot.parent = (pos->right ? next : pos);
+                    slot.left = (pos->right != nullptr);
+                    return insert_at(slot, value);
+                }
+            } else {
+                return iterator(pos);
+            }
             return insert(value).first;
         }
 
-        size_type erase(iterator pos) {
-            if (pos != end()) {
-                _root = __erase(_root, pos.base()->value);
-                _assign_paths_header();
-                --_size;
-                return 1;
-            } else {
-                return 0;
+        /* Unlinks the node behind pos directly: no search and no comparisons.
+         * Returns the iterator following pos. */
+        iterator erase(iterator pos) {
+            if (pos == end()) {
+                return pos;
+            }
+            iterator next = pos;
+            ++next;
+            _erase_node(pos.base());
+            return next;
+        }
+
+        /* Short ranges are unlinked node by node. Longer ones are cut out
+         * whole in O(log n) and then destroyed without rebalancing. */
+        iterator erase(iterator first, iterator last) {
+            if (first == begin() && last == end()) {
+                clear();
+                return end();
+            }
+            iterator it = first;
+            for (int steps = 0; it != last && steps < _short_range; ++steps) {
+                ++it;
+            }
+            if (it == last) {
+                while (first != last) {
+                    first = erase(first);
+                }
+                return last;
             }
+            size_type count;
+            node_pointer middle = _cut(first, last, count);
+            _delete_treap(middle);
+            return last;
         }
 
         void swap(Treap& other) {
             ft::swap(_allocator, other._allocator);
             ft::swap(_node_allocator, other._node_allocator);
+            _pool.swap(other._pool);
             ft::swap(_cmp, other._cmp);
             ft::swap(_root, other._root);
             ft::swap(_header, other._header);
+            ft::swap(_leftmost, other._leftmost);
+            ft::swap(_rightmost, other._rightmost);
             ft::swap(_size, other._size);
+            ft::swap(_finger, other._finger);
         }
 
-    /* Lookup */
+    /* Splitting and joining */
     public:
-        iterator find(const value_type& value) {
-            node_pointer pnode = _search(_root, value);
-            if (pnode) {
-                return iterator(pnode);
-            } else {
-                return end();
+        /* Moves the elements not less than key into upper, replacing its
+         * contents. Nodes change trees as they are, so iterators to them stay
+         * valid and now belong to upper. O(log n) with subtree sizes; without
+         * them the smaller side is also walked once to count it. */
+        template<class K>
+        void split(const K& key, Treap& upper) {
+            if (this == &upper) {
+                return;
+            }
+            upper.clear();
+            if (!(_node_allocator == upper._node_allocator)) {
+                iterator first = lower_bound(key);
+                for (iterator it = first; it != end(); ++it) {
+                    upper.insert_at(upper._slot_end(), *it);
+                }
+                erase(first, end());
+                return;
+            }
+            upper._pool.share(_pool);
+            size_type total = _size;
+            node_pointer bound = _lower_bound(key);
+            node_pointer lower_root;
+            node_pointer upper_root;
+            _split(_detach(), (bound != _header ? bound : nullptr), lower_root, upper_root);
+            size_type lower_size = _count_lower(lower_root, upper_root, total);
+            _attach(lower_root, lower_size);
+            upper._attach(upper_root, total - lower_size);
+        }
+
+        /* Moves [first, last) into out, replacing its contents. Same costs
+         * and iterator guarantees as split(). */
+        void extract(iterator first, iterator last, Treap& out) {
+            if (this == &out) {
+                return;
+            }
+            out.clear();
+            if (first == last) {
+                return;
+            }
+            if (!(_node_allocator == out._node_allocator)) {
+                for (iterator it = first; it != last; ++it) {
+                    out.insert_at(out._slot_end(), *it);
+                }
+                erase(first, last);
+                return;
+            }
+            out._pool.share(_pool);
+            size_type count;
+            node_pointer middle = _cut(first, last, count);
+            out._attach(middle, count);
+        }
+
+        /* Takes every element of other, leaving it empty. When all keys of
+         * one tree order before all keys of the other the two are joined in
+         * O(log n); otherwise the elements of other are inserted one by one
+         * and the ones already present here are dropped. */
+        void join(Treap& other) {
+            if (this == &other || other._size == 0) {
+                return;
             }
+            bool before = (_size == 0 || _cmp(_rightmost->value, other._leftmost->value));
+            bool after = (!before && _cmp(other._rightmost->value, _leftmost->value));
+            if (!(_node_allocator == other._node_allocator) || (!before && !after)) {
+                for (iterator it = other.begin(); it != other.end(); ++it) {
+                    insert(*it);
+                }
+                other.clear();
+                return;
+            }
+            _pool.adopt(other._pool);
+            size_type total = _size + other._size;
+            node_pointer root;
+            node_pointer lower = (before ? _detach() : other._detach());
+            node_pointer upper = (before ? other._detach() : _detach());
+            _thread_seam(lower, upper, lower);
+            root = _join2(lower, upper);
+            _attach(root, total);
         }
 
-        const_iterator find(const value_type& value) const {
-            node_pointer pnode = _search(_root, value);
-            if (pnode) {
-                return const_iterator(pnode);
-            } else {
-                return end();
+    /* Node handles */
+    public:
+        /* Takes the node at pos out of the tree, an empty handle for end() */
+        node_handle extract(iterator pos) {
+            if (pos == end()) {
+                return node_handle();
             }
+            node_pointer pnode = pos.base();
+            _unlink_node(pnode);
+            return node_handle(pnode, _pool.slab_of(pnode), _node_allocator);
         }
 
-        iterator lower_bound(const value_type& value) {
-            node_pointer less = nullptr;
-            if (_cmp(*--end(), value)) {
-                return end();
-            }
-            _first_less_than(_root, value, less);
-            if (less) {
-                return iterator(less);
-            } else {
-                return begin();
-            }
+        template<class K>
+        node_handle extract(const K& key) {
+            node_pointer pnode = _search(key);
+            return (pnode ? extract(iterator(pnode)) : node_handle());
         }
 
-        const_iterator lower_bound(const value_type& value) const {
-            node_pointer less = nullptr;
-            if (_cmp(*--end(), value)) {
-                return end();
+        /* Links the node of nh in when its key is absent here, emptying nh;
+         * otherwise nh keeps it. No copy and no allocation, unless the
+         * allocators differ. */
+        ft::pair<iterator, bool> insert(node_handle& nh) {
+            if (nh.empty()) {
+                return ft::make_pair(end(), false);
             }
-            _first_less_than(_root, value, less);
-            if (less) {
-                return const_iterator(less);
-            } else {
-                return begin();
+            slot_type slot;
+            node_pointer pnode = _locate(nh.value(), slot);
+            if (pnode) {
+                return ft::make_pair(iterator(pnode), false);
+            }
+            if (!(_node_allocator == nh._allocator)) {
+                iterator it = insert_at(slot, nh.value());
+                nh.reset();
+                return ft::make_pair(it, true);
+            }
+            _pool.hold(nh._slab);
+            NodePool<node_type, node_allocator>::release_slab(nh._allocator, nh._slab);
+            pnode = nh._pnode;
+            nh._pnode = nh._slab = nullptr;
+            return ft::make_pair(_link_at(slot, pnode), true);
+        }
+
+        /* Moves the nodes of other whose keys are absent here, without
+         * copying or allocating; the rest stay in other. Key ranges that do
+         * not interleave are joined in O(log n). This tree then holds all
+         * slabs of other as well. */
+        void merge(Treap& other) {
+            if (this == &other || other._size == 0) {
+                return;
+            }
+            if (_size == 0 || _cmp(_rightmost->value, other._leftmost->value) || _cmp(other._rightmost->value, _leftmost->value)) {
+                join(other);
+                return;
+            }
+            bool same_allocator = (_node_allocator == other._node_allocator);
+            if (same_allocator) {
+                _pool.share(other._pool);
+            }
+            for (iterator it = other.begin(); it != other.end(); ) {
+                node_pointer pnode = it.base();
+                ++it;
+                slot_type slot;
+                if (!_locate(pnode->value, slot)) {
+                    if (same_allocator) {
+                        other._unlink_node(pnode);
+                        _link_at(slot, pnode);
+                    } else {
+                        insert_at(slot, pnode->value);
+                        other._erase_node(pnode);
+                    }
+                }
             }
         }
 
-        iterator upper_bound(const value_type& value) {
-            node_pointer greater = nullptr;
-            _first_greater_than(_root, value, greater);
-            if (greater) {
-                return iterator(greater);
+    /* Lookup */
+    public:
+        template<class K>
+        iterator find(const K& key) {
+            node_pointer pnode = _search(key);
+            if (pnode) {
+                _touch(pnode, _balancing());
+                return iterator(pnode);
             } else {
                 return end();
             }
         }
 
-        const_iterator upper_bound(const value_type& value) const {
-            node_pointer greater = nullptr;
-            _first_greater_than(_root, value, greater);
-            if (greater) {
-                return const_iterator(greater);
+        template<class K>
+        const_iterator find(const K& key) const {
+            node_pointer pnode = _search(key);
+            if (pnode) {
+                return const_iterator(pnode);
             } else {
                 return end();
             }
         }
 
-    /* Observers */
-    public:
-        compare_type value_comp() {
-            return _cmp;
+        template<class K>
+        iterator lower_bound(const K& key) {
+            node_pointer bound = _lower_bound(key);
+            _touch(bound, _balancing());
+            return iterator(bound);
         }
 
-    /* private helpers */
-    private:
-        size_type _height(node_pointer pnode) {
-            if (pnode) {
-                return pnode->height;
-            } else {
-                return 0;
-            }
+        template<class K>
+        const_iterator lower_bound(const K& key) const {
+            return const_iterator(_lower_bound(key));
         }
 
-        int _bfactor(node_pointer pnode) {
-            return _height(pnode->right) - _height(pnode->left);
+        template<class K>
+        iterator upper_bound(const K& key) {
+            node_pointer bound = _upper_bound(key);
+            _touch(bound, _balancing());
+            return iterator(bound);
         }
 
-        void _fix_height(node_pointer pnode) {
-            size_t hl = _height(pnode->left);
-            size_t hr = _height(pnode->right);
-            pnode->height = (hl > hr ? hl : hr) + 1;
+        template<class K>
+        const_iterator upper_bound(const K& key) const {
+            return const_iterator(_upper_bound(key));
         }
 
-        node_pointer _rotate_right(node_pointer p) { //need to assign parents
-            node_pointer q = p->left;
+        /* find() for every key of [first, last), written to out in order.
+         * Never restructures a splay tree. */
+        template<class ForwardIt, class OutputIt>
+        OutputIt find_many(ForwardIt first, ForwardIt last, OutputIt out) {
+            return _find_many<iterator>(first, last, out);
+        }
+
+        template<class ForwardIt, class OutputIt>
+        OutputIt find_many(ForwardIt first, ForwardIt last, OutputIt out) const {
+            return _find_many<const_iterator>(first, last, out);
+        }
+
+    /* Order statistics, with ft::size_augment */
+    public:
+        /* The k-th element in order, or end() when k >= size() */
+        iterator nth(size_type k) {
+            return iterator(_nth(k));
+        }
+
+        const_iterator nth(size_type k) const {
+            return const_iterator(_nth(k));
+        }
+
+        /* Number of elements less than key */
+        template<class K>
+        size_type rank(const K& key) const {
+            node_pointer pnode = (_root != _header ? _root : nullptr);
+            size_type rank = 0;
+            while (pnode) {
+                if (_cmp(pnode->value, key)) {
+                    rank += _subtree_size(pnode->left) + 1;
+                    pnode = pnode->right;
+                } else {
+                    pnode = pnode->left;
+                }
+            }
+            return rank;
+        }
+
+        /* Position of pos in order, size() for end() */
+        template<class It>
+        size_type index(It pos) const {
+            node_pointer pnode = pos.base();
+            if (pnode == _header) {
+                return _size;
+            }
+            size_type index = _subtree_size(pnode->left);
+            for (; pnode->parent != _header; pnode = pnode->parent) {
+                if (pnode->parent->right == pnode) {
+                    index += _subtree_size(pnode->parent->left) + 1;
+                }
+            }
+            return index;
+        }
+
+    /* Range aggregates, with ft::monoid_augment */
+    public:
+        /* Aggregate of the elements with keys in [lo, hi): the aggregates
+         * of whole subtrees along the two boundary paths, O(log n) */
+        template<class K>
+        aggregate_type aggregate(const K& lo, const K& hi) const {
+            node_pointer split = (_root != _header ? _root : nullptr);
+            while (split) {
+                if (_cmp(split->value, lo)) {
+                    split = split->right;
+                } else if (!_cmp(split->value, hi)) {
+                    split = split->left;
+                } else {
+                    break;
+                }
+            }
+            if (!split) {
+                return monoid_type::identity();
+            }
+            aggregate_type lower = monoid_type::identity();
+            for (node_pointer pnode = split->left; pnode; ) {
+                if (_cmp(pnode->value, lo)) {
+                    pnode = pnode->right;
+                } else {
+                    lower = monoid_type::combine(monoid_type::lift(pnode->value),
+                                                 monoid_type::combine(_aggregate_of(pnode->right), lower));
+                    pnode = pnode->left;
+                }
+            }
+            aggregate_type upper = monoid_type::identity();
+            for (node_pointer pnode = split->right; pnode; ) {
+                if (_cmp(pnode->value, hi)) {
+                    upper = monoid_type::combine(monoid_type::combine(upper, _aggregate_of(pnode->left)),
+                                                 monoid_type::lift(pnode->value));
+                    pnode = pnode->right;
+                } else {
+                    pnode = pnode->left;
+                }
+            }
+            return monoid_type::combine(lower, monoid_type::combine(monoid_type::lift(split->value), upper));
+        }
+
+        /* Aggregate of every element, O(1) */
+        aggregate_type aggregate() const {
+            return _aggregate_of(_root != _header ? _root : nullptr);
+        }
+
+        /* Recomputes the augmentations above pos after its value changed in
+         * place, as insert_or_assign() does to a mapped value */
+        void refresh(iterator pos) {
+            _update_path(pos.base());
+        }
+
+    /* Observers */
+    public:
+        compare_type value_comp() {
+            return _cmp;
+        }
+
+    /* private helpers */
+    private:
+        template<class K>
+        node_pointer _locate(const K& key, slot_type& slot) const {
+            node_pointer pnode = _start(key);
+            node_pointer candidate = nullptr;
+            slot.parent = _header;
+            slot.left = true;
+            while (pnode) {
+                slot.parent = pnode;
+                if (_cmp(key, pnode->value)) {
+                    slot.left = true;
+                    pnode = pnode->left;
+                } else {
+                    candidate = pnode;
+                    slot.left = false;
+                    pnode = pnode->right;
+                }
+            }
+            if (candidate && !_cmp(candidate->value, key)) {
+                _remember(candidate);
+                return candidate;
+            }
+            if (slot.parent != _header) {
+                _remember(slot.parent);
+            }
+            return nullptr;
+        }
+
+
+        size_type _height(node_pointer pnode) {
+            if (pnode) {
+                return pnode->height;
+            } else {
+                return 0;
+            }
+        }
+
+        int _bfactor(node_pointer pnode) {
+            return _height(pnode->right) - _height(pnode->left);
+        }
+
+        size_type _subtree_size(node_pointer pnode) const {
+            return (pnode ? pnode->size : 0);
+        }
+
+        aggregate_type _aggregate_of(node_pointer pnode) const {
+            return (pnode ? pnode->aggregate : monoid_type::identity());
+        }
+
+        node_pointer _nth(size_type k) const {
+            if (k >= _size) {
+                return _header;
+            }
+            node_pointer pnode = _root;
+            while (true) {
+                size_type left = _subtree_size(pnode->left);
+                if (k < left) {
+                    pnode = pnode->left;
+                } else if (k == left) {
+                    return pnode;
+                } else {
+                    k -= left + 1;
+                    pnode = pnode->right;
+                }
+            }
+        }
+
+        /* Recomputes everything a node derives from its children */
+        void _fix_height(node_pointer pnode) {
+            _fix_balance(pnode, _balancing());
+            augment_type::update(pnode);
+        }
+
+        node_pointer _rotate_right(node_pointer p) { //need to assign parents
+            node_pointer q = p->left;
             q->parent = p->parent;
             p->left = q->right;
             if (q->right) {
@@ -482,83 +1233,127 @@ namespace ft {
             return pnode;
         }
 
-        node_pointer __erase(node_pointer pnode, const value_type& value) // удаление ключа k из дерева p
-        {
-            if(!pnode) {
-                return nullptr;
-            }
-            if(_cmp(value, pnode->value)) {
-                pnode->left = __erase(pnode->left, value);
-                if (pnode->left) {
-                    pnode->left->parent = pnode;
-                }
-            } else if(_cmp(pnode->value, value)) {
-                pnode->right = __erase(pnode->right, value);
-                if (pnode->right) {
-                    pnode->right->parent = pnode;
-                }
+        /* Links a node that is in no tree into slot and rebalances upwards */
+        iterator _link_at(const slot_type& slot, node_pointer pnode) {
+            pnode->left = pnode->right = nullptr;
+            _init_balance(pnode, _balancing());
+            augment_type::update(pnode);
+            pnode->parent = slot.parent;
+            if (slot.parent == _header) {
+                _root = _leftmost = _rightmost = pnode;
+                _assign_paths_header();
             } else {
-                node_pointer q = pnode->left;
-                node_pointer r = pnode->right;
-                if (!r) {
-                    if (q) {
-                        q->parent = pnode->parent;
+                if (slot.left) {
+                    slot.parent->left = pnode;
+                    if (slot.parent == _leftmost) {
+                        _leftmost = pnode;
+                    }
+                } else {
+                    slot.parent->right = pnode;
+                    if (slot.parent == _rightmost) {
+                        _rightmost = pnode;
                     }
-                    _delete_node(pnode);
-                    return q;
-                }
-                node_pointer min = _subtree_min(r);
-                min->right = __erase_subtree_min(r);
-                if (min->right) {
-                    min->right->parent = min;
-                }
-                min->left = q;
-                if (q) {
-                    q->parent = min;
                 }
-                return _balance(min);
             }
-            return _balance(pnode);
+            _rebalance_insert(pnode, _balancing());
+            _thread_insert(pnode, slot, pnode);
+            ++_size;
+            _remember(pnode);
+            return iterator(pnode);
+        }
+
+        void _erase_node(node_pointer pnode) {
+            _unlink_node(pnode);
+            _delete_node(pnode);
         }
 
-        node_pointer __erase_subtree_min(node_pointer p)
-        {
-            if (!p->left) {
-                return p->right;
+        /* Unlinks pnode, puts its successor in its place when it has two
+         * children, and rebalances upwards from the lowest changed node.
+         * child took the place that was removed, removed had its word. */
+        void _unlink_node(node_pointer pnode) {
+            if (pnode == _finger) {
+                _finger = nullptr;
             }
-            p->left = __erase_subtree_min(p->left);
-            if (p->left) {
-                p->left->parent = p;
+            _prepare_unlink(pnode, _balancing());
+            node_pointer parent = pnode->parent;
+            node_pointer rebalance_from = parent;
+            node_pointer child;
+            size_type removed = pnode->height;
+            if (pnode == _leftmost) {
+                _leftmost = (_size > 1 ? (++iterator(pnode)).base() : _header);
+            }
+            if (pnode == _rightmost) {
+                _rightmost = (_size > 1 ? (--iterator(pnode)).base() : _header);
+            }
+            _thread_unlink(pnode, pnode);
+            if (!pnode->left || !pnode->right) {
+                child = (pnode->left ? pnode->left : pnode->right);
+                if (child) {
+                    child->parent = parent;
+                }
+                _replace_child(parent, pnode, child);
+            } else {
+                node_pointer successor = _subtree_min(pnode->right);
+                child = successor->right;
+                removed = successor->height;
+                if (successor->parent != pnode) {
+                    rebalance_from = successor->parent;
+                    successor->parent->left = successor->right;
+                    if (successor->right) {
+                        successor->right->parent = successor->parent;
+                    }
+                    successor->right = pnode->right;
+                    pnode->right->parent = successor;
+                } else {
+                    rebalance_from = successor;
+                }
+                successor->left = pnode->left;
+                pnode->left->parent = successor;
+                successor->parent = parent;
+                successor->height = pnode->height;
+                _replace_child(parent, pnode, successor);
+            }
+            --_size;
+            _rebalance_erase(rebalance_from, child, removed, _balancing());
+        }
+
+        void _rebalance_up(node_pointer pnode) {
+            while (pnode != _header) {
+                node_pointer parent = pnode->parent;
+                size_type height = pnode->height;
+                node_pointer subtree = _balance(pnode);
+                _replace_child(parent, pnode, subtree);
+                if (subtree->height == height) {
+                    _update_path(parent);
+                    break;
+                }
+                pnode = parent;
             }
-            return _balance(p);
         }
 
-        void _insert_avl(const value_type& value) {
-            if (_root == _header) {
-                _root = __insert(nullptr, value);
-                _assign_paths_header();
-                ++_size;
-            }
-            else if (!_search(_root, value)) {
-               _root = __insert(_root, value);
-                _assign_paths_header();
-                ++_size;
+        /* Heights above pnode are settled, augmentations still change up to the root */
+        void _update_path(node_pointer pnode) {
+            if (augment_type::enabled) {
+                for (; pnode && pnode != _header; pnode = pnode->parent) {
+                    augment_type::update(pnode);
+                }
             }
         }
 
-        node_pointer __insert(node_pointer root, const value_type& value) {
-            if (!root) {
-                root = _create_node(value);
-            } else {
-                if (_cmp(value, root->value)) {
-                    root->left = __insert(root->left, value);
-                    root->left->parent = root;
-                } else if (_cmp(root->value, value)) {
-                    root->right = __insert(root->right, value);
-                    root->right->parent = root;
+        void _replace_child(node_pointer parent, node_pointer from, node_pointer to) {
+            if (parent == _header) {
+                if (to) {
+                    _root = to;
+                    _assign_paths_header();
+                } else {
+                    _root = _header;
+                    _header->left = _header->right = nullptr;
                 }
+            } else if (parent->left == from) {
+                parent->left = to;
+            } else {
+                parent->right = to;
             }
-            return _balance(root);
         }
 
         void _assign_paths_header() {
@@ -568,62 +1363,102 @@ namespace ft {
             }
         }
 
-        void _insert_all_nodes(node_pointer to, node_pointer from) {
-            if (from) {
-                _insert_avl(from->value);
-                _insert_all_nodes(to, from->left);
-                _insert_all_nodes(to, from->right);
+        /* Links nodes, sorted and unique, into a perfectly balanced subtree.
+         * Heights follow from the counts, so every node is touched once.
+         * Levels counts down to the last level, which may be incomplete. */
+        node_pointer _build_balanced(node_pointer* nodes, size_type count, node_pointer parent, size_type levels) {
+            if (count == 0) {
+                return nullptr;
             }
+            size_type middle = count / 2;
+            node_pointer pnode = nodes[middle];
+            pnode->parent = parent;
+            pnode->left = _build_balanced(nodes, middle, pnode, levels - 1);
+            pnode->right = _build_balanced(nodes + middle + 1, count - middle - 1, pnode, levels - 1);
+            _build_balance(pnode, count, levels, _balancing());
+            augment_type::update(pnode);
+            return pnode;
         }
 
-        void _first_less_than(node_pointer pnode, const value_type& than, node_pointer& less) const {
-            if (pnode) {
-                if (_cmp(than, pnode->value)) {
-                    _first_less_than(pnode->left, than, less);
-                } else if (_cmp(pnode->value, than)) {
-                    less = _max_node(less, pnode);
-                    _first_less_than(pnode->right, than, less);
-                } else {
-                    less = pnode;
-                }
+        /* Copies the shape of other as is: no comparisons, no rebalancing */
+        void _clone(const Treap& other) {
+            if (other._size > 0) {
+                _pool.reserve(other._size);
+                _root = _clone_subtree(other._root, _header);
+                _assign_paths_header();
+                _leftmost = _subtree_min(_root);
+                _rightmost = _subtree_max(_root);
+                _size = other._size;
+                _thread_all();
             }
         }
 
-        void _first_greater_than(node_pointer pnode, const value_type& than, node_pointer& greater) const {
-            if (pnode) {
-                if (_cmp(than, pnode->value)) {
-                    greater = _min_node(greater, pnode);
-                    _first_greater_than(pnode->left, than, greater);
+        /* Pre-order walk of from, mirrored in the copy through parent pointers */
+        node_pointer _clone_subtree(node_pointer from, node_pointer parent) {
+            node_pointer root = _clone_node(from, parent);
+            node_pointer source = from;
+            node_pointer copy = root;
+            while (true) {
+                if (source->left && !copy->left) {
+                    copy->left = _clone_node(source->left, copy);
+                    source = source->left;
+                    copy = copy->left;
+                } else if (source->right && !copy->right) {
+                    copy->right = _clone_node(source->right, copy);
+                    source = source->right;
+                    copy = copy->right;
+                } else if (source != from) {
+                    source = source->parent;
+                    copy = copy->parent;
                 } else {
-                    _first_greater_than(pnode->right, than, greater);
+                    return root;
                 }
             }
         }
 
-        node_pointer _max_node(node_pointer lhs, node_pointer rhs) const {
-            if (!lhs) {
-                return rhs;
-            } else if (!rhs) {
-                return lhs;
-            }
-            if (_cmp(lhs->value, rhs->value)) {
-                return rhs;
-            } else {
-                return lhs;
-            }
+        node_pointer _clone_node(node_pointer from, node_pointer parent) {
+            node_pointer pnode = _create_node(from->value);
+            pnode->height = from->height;
+            static_cast<node_data&>(*pnode) = static_cast<const node_data&>(*from);
+            pnode->parent = parent;
+            return pnode;
         }
 
-        node_pointer _min_node(node_pointer lhs, node_pointer rhs) const {
-            if (!lhs) {
-                return rhs;
-            } else if (!rhs) {
-                return lhs;
+        /* First node not less than key, or the header */
+        template<class K>
+        node_pointer _lower_bound(const K& key) const {
+            node_pointer pnode = _start(key);
+            node_pointer bound = _header;
+            node_pointer last = pnode;
+            while (pnode) {
+                last = pnode;
+                if (_cmp(pnode->value, key)) {
+                    pnode = pnode->right;
+                } else {
+                    bound = pnode;
+                    pnode = pnode->left;
+                }
             }
-            if (_cmp(lhs->value, rhs->value)) {
-                return lhs;
-            } else {
-                return rhs;
+            if (last) {
+                _remember(bound != _header ? bound : last);
+            }
+            return bound;
+        }
+
+        /* First node greater than key, or the header */
+        template<class K>
+        node_pointer _upper_bound(const K& key) const {
+            node_pointer pnode = (_root != _header ? _root : nullptr);
+            node_pointer bound = _header;
+            while (pnode) {
+                if (_cmp(key, pnode->value)) {
+                    bound = pnode;
+                    pnode = pnode->left;
+                } else {
+                    pnode = pnode->right;
+                }
             }
+            return bound;
         }
 
         node_pointer _subtree_min(node_pointer treap) const {
@@ -641,45 +1476,893 @@ namespace ft {
         }
 
         node_pointer _create_node(const value_type& value) {
-            node_pointer pnode = _node_allocator.allocate(1);
+            node_pointer pnode = _pool.allocate();
             _node_allocator.construct(pnode, value);
+            augment_type::update(pnode);
             return pnode;
         }
 
-        node_pointer _search(node_pointer treap, const value_type& value) const {
-            if (!treap) {
-                return nullptr;
-            } else {
-                if (_cmp(value, treap->value)) {
-                    return _search(treap->left, value);
-                } else if (_cmp(treap->value, value)) {
-                    return _search(treap->right, value);
-                } else {
-                    return treap;
+        /* Searches _batch keys at a time in lockstep: every search takes one
+         * step down before any takes the next, and prefetches the node it
+         * moves to. A lone search waits on one cache miss per level; here
+         * the misses of the whole batch are in flight together. */
+        template<class It, class ForwardIt, class OutputIt>
+        OutputIt _find_many(ForwardIt first, ForwardIt last, OutputIt out) const {
+            ForwardIt keys[_batch];
+            node_pointer nodes[_batch];
+            node_pointer bounds[_batch];
+            node_pointer root = (_root != _header ? _root : nullptr);
+            while (first != last) {
+                size_type count = 0;
+                for (; count < _batch && first != last; ++count, ++first) {
+                    keys[count] = first;
+                    nodes[count] = root;
+                    bounds[count] = _header;
                 }
+                for (bool active = (root != nullptr); active; ) {
+                    active = false;
+                    for (size_type i = 0; i < count; ++i) {
+                        node_pointer pnode = nodes[i];
+                        if (!pnode) {
+                            continue;
+                        }
+                        if (_cmp(pnode->value, *keys[i])) {
+                            pnode = pnode->right;
+                        } else {
+                            bounds[i] = pnode;
+                            pnode = pnode->left;
+                        }
+                        if (pnode) {
+                            __builtin_prefetch(pnode);
+                            active = true;
+                        }
+                        nodes[i] = pnode;
+                    }
+                }
+                for (size_type i = 0; i < count; ++i, ++out) {
+                    node_pointer bound = bounds[i];
+                    *out = It((bound != _header && !_cmp(*keys[i], bound->value)) ? bound : _header);
+                }
+            }
+            return out;
+        }
+
+        template<class K>
+        node_pointer _search(const K& key) const {
+            node_pointer pnode = _lower_bound(key);
+            if (pnode != _header && !_cmp(key, pnode->value)) {
+                return pnode;
             }
+            return nullptr;
         }
 
+        /* Post-order deletion through parent pointers, no stack */
         void _delete_treap(node_pointer root) {
-            if (root) {
-                _delete_treap(root->left);
-                _delete_treap(root->right);
-                _delete_node(root);
+            node_pointer stop = root->parent;
+            node_pointer pnode = root;
+            while (pnode != stop) {
+                if (pnode->left) {
+                    pnode = pnode->left;
+                } else if (pnode->right) {
+                    pnode = pnode->right;
+                } else {
+                    node_pointer parent = pnode->parent;
+                    if (parent != stop) {
+                        if (parent->left == pnode) {
+                            parent->left = nullptr;
+                        } else {
+                            parent->right = nullptr;
+                        }
+                    }
+                    _delete_node(pnode);
+                    pnode = parent;
+                }
             }
         }
 
         void _delete_node(node_pointer node) {
             _node_allocator.destroy(node);
-            _node_allocator.deallocate(node, 1);
+            _pool.deallocate(node);
+        }
+
+        /* Slot after the last element */
+        slot_type _slot_end() const {
+            slot_type slot;
+            slot.parent = (_root != _header ? _rightmost : _header);
+            slot.left = false;
+            return slot;
+        }
+
+        /* Takes the whole tree out as a detached subtree, leaving this empty */
+        node_pointer _detach() {
+            if (_root == _header) {
+                return nullptr;
+            }
+            node_pointer root = _root;
+            root->parent = nullptr;
+            _root = _leftmost = _rightmost = _header;
+            _header->left = _header->right = nullptr;
+            _size = 0;
+            _finger = nullptr;
+            _thread_ends();
+            return root;
+        }
+
+        /* Makes a detached subtree of size nodes the contents of an empty tree */
+        void _attach(node_pointer root, size_type size) {
+            if (root) {
+                _root = root;
+                _assign_paths_header();
+                _leftmost = _subtree_min(_root);
+                _rightmost = _subtree_max(_root);
+                _size = size;
+                _thread_ends();
+            }
+        }
+
+        /* Detaches [first, last) as one subtree, count gets its size */
+        node_pointer _cut(iterator first, iterator last, size_type& count) {
+            size_type total = _size;
+            node_pointer lower;
+            node_pointer middle;
+            node_pointer upper = nullptr;
+            node_pointer root = _detach();
+            _split(root, first.base(), lower, middle);
+            if (last != end()) {
+                root = middle;
+                _split(root, last.base(), middle, upper);
+            }
+            _thread_seam(lower, upper, lower);
+            root = _join2(lower, upper);
+            count = _count_lower(middle, root, total);
+            _attach(root, total - count);
+            return middle;
+        }
+
+        /* Splits a detached subtree into the nodes before pos and the rest,
+         * all of it when pos is null. The path from pos is walked up to the
+         * top, each node joining its off-path child on its own side; no
+         * comparisons, and the joins add up to O(log n). */
+        void _split(node_pointer root, node_pointer pos, node_pointer& lower, node_pointer& upper) {
+            if (!pos) {
+                lower = root;
+                upper = nullptr;
+                return;
+            }
+            node_pointer parent = pos->parent;
+            lower = pos->left;
+            if (lower) {
+                lower->parent = nullptr;
+            }
+            upper = _join(nullptr, pos, pos->right);
+            for (node_pointer from = pos, pnode = parent; pnode; from = pnode, pnode = parent) {
+                parent = pnode->parent;
+                if (pnode->right == from) {
+                    lower = _join(pnode->left, pnode, lower);
+                } else {
+                    upper = _join(upper, pnode, pnode->right);
+                }
+            }
+        }
+
+        /* Joins detached subtrees under k, all of left < k < all of right */
+        node_pointer _join(node_pointer left, node_pointer k, node_pointer right) {
+            if (left) {
+                left->parent = nullptr;
+            }
+            if (right) {
+                right->parent = nullptr;
+            }
+            k->parent = nullptr;
+            return _join(left, k, right, _balancing());
+        }
+
+        /* The taller one is descended along its inner spine to where the
+         * other fits, so the cost is the height difference */
+        node_pointer _join(node_pointer left, node_pointer k, node_pointer right, const avl_balance*) {
+            size_type hl = _height(left);
+            size_type hr = _height(right);
+            if (hl > hr + 1) {
+                node_pointer seam = left;
+                node_pointer parent = nullptr;
+                while (_height(seam) > hr + 1) {
+                    parent = seam;
+                    seam = seam->right;
+                }
+                _link(k, seam, right);
+                k->parent = parent;
+                parent->right = k;
+                return _rebalance_top(parent);
+            }
+            if (hr > hl + 1) {
+                node_pointer seam = right;
+                node_pointer parent = nullptr;
+                while (_height(seam) > hl + 1) {
+                    parent = seam;
+                    seam = seam->left;
+                }
+                _link(k, left, seam);
+                k->parent = parent;
+                parent->left = k;
+                return _rebalance_top(parent);
+            }
+            _link(k, left, right);
+            k->parent = nullptr;
+            return k;
+        }
+
+        /* Joins detached subtrees without a middle node: the largest node
+         * of left is taken out and used as one */
+        node_pointer _join2(node_pointer left, node_pointer right) {
+            if (!left || !right) {
+                node_pointer root = (left ? left : right);
+                if (root) {
+                    root->parent = nullptr;
+                }
+                return root;
+            }
+            left->parent = nullptr;
+            node_pointer k = _subtree_max(left);
+            node_pointer parent = k->parent;
+            if (k->left) {
+                k->left->parent = parent;
+            }
+            if (parent) {
+                parent->right = k->left;
+                left = _rebalance_detached(parent, k->left, k->height, _balancing());
+            } else {
+                left = k->left;
+            }
+            return _join(left, k, right);
+        }
+
+        void _link(node_pointer pnode, node_pointer left, node_pointer right) {
+            pnode->left = left;
+            pnode->right = right;
+            if (left) {
+                left->parent = pnode;
+            }
+            if (right) {
+                right->parent = pnode;
+            }
+            _fix_height(pnode);
+        }
+
+        /* Rebalances from pnode to the top of a detached subtree, returns the new top */
+        node_pointer _rebalance_top(node_pointer pnode) {
+            while (true) {
+                node_pointer parent = pnode->parent;
+                node_pointer subtree = _balance(pnode);
+                if (!parent) {
+                    return subtree;
+                }
+                if (parent->left == pnode) {
+                    parent->left = subtree;
+                } else {
+                    parent->right = subtree;
+                }
+                pnode = parent;
+            }
+        }
+
+        /* Size of lower, of two detached subtrees holding total nodes: read
+         * off the root with subtree sizes, otherwise both are walked in step
+         * until the smaller one runs out */
+        size_type _count_lower(node_pointer lower, node_pointer upper, size_type total) const {
+            return _count_lower(lower, upper, total, static_cast<node_data*>(nullptr));
+        }
+
+        size_type _count_lower(node_pointer lower, node_pointer, size_type, const size_augment::node_data*) const {
+            return _subtree_size(lower);
+        }
+
+        size_type _count_lower(node_pointer lower, node_pointer upper, size_type total, const void*) const {
+            node_pointer a = (lower ? _subtree_min(lower) : nullptr);
+            node_pointer b = (upper ? _subtree_min(upper) : nullptr);
+            size_type count = 0;
+            while (a && b) {
+                a = _detached_next(a);
+                b = _detached_next(b);
+                ++count;
+            }
+            return (a ? total - count : count);
+        }
+
+        node_pointer _detached_next(node_pointer pnode) const {
+            if (pnode->right) {
+                return _subtree_min(pnode->right);
+            }
+            while (pnode->parent && pnode->parent->right == pnode) {
+                pnode = pnode->parent;
+            }
+            return pnode->parent;
+        }
+
+        /* Balancing, one overload per policy; the void ones do nothing */
+        static balance_type* _balancing() {
+            return nullptr;
+        }
+
+        /* Word of a node recomputed from its children */
+        void _fix_balance(node_pointer pnode, const avl_balance*) {
+            size_t hl = _height(pnode->left);
+            size_t hr = _height(pnode->right);
+            pnode->height = (hl > hr ? hl : hr) + 1;
+        }
+
+        void _fix_balance(node_pointer, const void*) {
+        }
+
+        /* Word of a node about to be linked in as a leaf */
+        void _init_balance(node_pointer pnode, const avl_balance*) {
+            pnode->height = 1;
+        }
+
+        void _init_balance(node_pointer pnode, const red_black_balance*) {
+            pnode->height = red_black_balance::red;
+        }
+
+        void _init_balance(node_pointer pnode, const treap_balance*) {
+            pnode->height = _priority(pnode);
+        }
+
+        void _init_balance(node_pointer, const void*) {
+        }
+
+        /* Word of a node linked by _build_balanced(), count nodes in its subtree */
+        void _build_balance(node_pointer pnode, size_type count, size_type, const avl_balance*) {
+            pnode->height = 0;
+            for (; count > 0; count /= 2) {
+                ++pnode->height;
+            }
+        }
+
+        /* Every level is complete but the last, which is red */
+        void _build_balance(node_pointer pnode, size_type, size_type levels, const red_black_balance*) {
+            pnode->height = (levels == 0 ? red_black_balance::red : red_black_balance::black);
+        }
+
+        void _build_balance(node_pointer, size_type, size_type, const void*) {
+        }
+
+        /* Detached subtree of count sorted nodes */
+        node_pointer _build(node_pointer* nodes, size_type count, const void*) {
+            size_type levels = 0;
+            for (size_type complete = count + 1; complete > 1; complete /= 2) {
+                ++levels;
+            }
+            return _build_balanced(nodes, count, nullptr, levels);
+        }
+
+        /* Cartesian tree in O(n): each node goes to the bottom of the right
+         * spine, taking the nodes of lower priority as its left subtree */
+        node_pointer _build(node_pointer* nodes, size_type count, const treap_balance*) {
+            node_pointer last = nullptr;
+            for (size_type i = 0; i < count; ++i) {
+                node_pointer pnode = nodes[i];
+                node_pointer below = nullptr;
+                pnode->height = _priority(pnode);
+                while (last && last->height < pnode->height) {
+                    _fix_height(last);
+                    below = last;
+                    last = last->parent;
+                }
+                pnode->left = below;
+                pnode->right = nullptr;
+                pnode->parent = last;
+                if (below) {
+                    below->parent = pnode;
+                }
+                if (last) {
+                    last->right = pnode;
+                }
+                last = pnode;
+            }
+            node_pointer root = last;
+            for (; last; last = last->parent) {
+                _fix_height(last);
+                root = last;
+            }
+            return root;
+        }
+
+        /* Restores the shape after pnode was linked in as a leaf */
+        void _rebalance_insert(node_pointer pnode, const avl_balance*) {
+            if (pnode->parent != _header) {
+                _rebalance_up(pnode->parent);
+            }
+        }
+
+        void _rebalance_insert(node_pointer pnode, const red_black_balance*) {
+            _update_path(pnode->parent);
+            _fix_red(pnode);
+        }
+
+        void _rebalance_insert(node_pointer pnode, const treap_balance*) {
+            _update_path(pnode->parent);
+            while (!_above_top(pnode->parent) && pnode->parent->height < pnode->height) {
+                _rotate_up(pnode);
+            }
+        }
+
+        void _rebalance_insert(node_pointer pnode, const splay_balance*) {
+            _update_path(pnode->parent);
+            _splay(pnode);
+        }
+
+        /* Rotates a treap node down until it has one child at most, so that
+         * taking it out keeps the heap order and the priorities random */
+        void _prepare_unlink(node_pointer pnode, const treap_balance*) {
+            while (pnode->left && pnode->right) {
+                _rotate_up(pnode->left->height > pnode->right->height ? pnode->left : pnode->right);
+            }
+        }
+
+        void _prepare_unlink(node_pointer, const void*) {
+        }
+
+        /* Restores the shape after a node with the word removed was taken out
+         * below from, child taking its place */
+        void _rebalance_erase(node_pointer from, node_pointer, size_type, const avl_balance*) {
+            _rebalance_up(from);
+        }
+
+        void _rebalance_erase(node_pointer from, node_pointer child, size_type removed, const red_black_balance*) {
+            _update_path(from);
+            if (removed == red_black_balance::black) {
+                _fix_black(child, from);
+            }
+        }
+
+        void _rebalance_erase(node_pointer from, node_pointer, size_type, const treap_balance*) {
+            _update_path(from);
+        }
+
+        void _rebalance_erase(node_pointer from, node_pointer, size_type, const splay_balance*) {
+            _update_path(from);
+            if (from != _header) {
+                _splay(from);
+            }
+        }
+
+        /* The same in a detached subtree, returns its new top */
+        node_pointer _rebalance_detached(node_pointer from, node_pointer, size_type, const avl_balance*) {
+            return _rebalance_top(from);
+        }
+
+        node_pointer _rebalance_detached(node_pointer from, node_pointer child, size_type removed, const red_black_balance* tag) {
+            _rebalance_erase(from, child, removed, tag);
+            return _top_of(from);
+        }
+
+        node_pointer _rebalance_detached(node_pointer from, node_pointer, size_type, const void*) {
+            _update_path(from);
+            return _top_of(from);
+        }
+
+        /* Blackens both tops and links k red under the black node of equal
+         * black height on the inner spine of the taller one */
+        node_pointer _join(node_pointer left, node_pointer k, node_pointer right, const red_black_balance*) {
+            if (left) {
+                left->height = red_black_balance::black;
+            }
+            if (right) {
+                right->height = red_black_balance::black;
+            }
+            size_type hl = _black_height(left);
+            size_type hr = _black_height(right);
+            if (hl == hr) {
+                _link(k, left, right);
+                k->height = red_black_balance::black;
+                return k;
+            }
+            node_pointer parent = nullptr;
+            node_pointer seam = (hl > hr ? left : right);
+            size_type height = (hl > hr ? hl : hr);
+            size_type target = (hl > hr ? hr : hl);
+            while (!_is_black(seam) || height != target) {
+                if (_is_black(seam)) {
+                    --height;
+                }
+                parent = seam;
+                seam = (hl > hr ? seam->right : seam->left);
+            }
+            if (hl > hr) {
+                _link(k, seam, right);
+                parent->right = k;
+            } else {
+                _link(k, left, seam);
+                parent->left = k;
+            }
+            k->parent = parent;
+            k->height = red_black_balance::red;
+            _update_path(parent);
+            _fix_red(k);
+            return _top_of(k);
+        }
+
+        /* Links k on top and sifts it down to its priority */
+        node_pointer _join(node_pointer left, node_pointer k, node_pointer right, const treap_balance*) {
+            _link(k, left, right);
+            while (true) {
+                node_pointer child = k->left;
+                if (!child || (k->right && k->right->height > child->height)) {
+                    child = k->right;
+                }
+                if (!child || child->height <= k->height) {
+                    break;
+                }
+                _rotate_up(child);
+            }
+            return _top_of(k);
+        }
+
+        /* Splaying pays for the depth later */
+        node_pointer _join(node_pointer left, node_pointer k, node_pointer right, const splay_balance*) {
+            _link(k, left, right);
+            return k;
+        }
+
+        /* A lookup reached pnode */
+        void _touch(node_pointer pnode, const splay_balance*) {
+            if (pnode != _header) {
+                _splay(pnode);
+            }
+        }
+
+        void _touch(node_pointer, const void*) {
+        }
+
+        /* Where a search for key starts: the root, or with finger_augment
+         * the lowest ancestor of the finger whose subtree holds key. Above
+         * the finger, a left child's parent bounds its subtree from above
+         * and a right child's parent from below. */
+        template<class K>
+        node_pointer _start(const K& key) const {
+            return _start(key, static_cast<node_data*>(nullptr));
+        }
+
+        template<class K>
+        node_pointer _start(const K& key, const finger_augment::node_data*) const {
+            node_pointer pnode = _finger;
+            if (!pnode) {
+                return (_root != _header ? _root : nullptr);
+            }
+            if (_cmp(pnode->value, key)) {
+                for (; pnode->parent != _header; pnode = pnode->parent) {
+                    if (pnode->parent->left == pnode && !_cmp(pnode->parent->value, key)) {
+                        return pnode->parent;
+                    }
+                }
+            } else if (_cmp(key, pnode->value)) {
+                for (; pnode->parent != _header; pnode = pnode->parent) {
+                    if (pnode->parent->right == pnode && _cmp(pnode->parent->value, key)) {
+                        return pnode->parent;
+                    }
+                }
+            }
+            return pnode;
+        }
+
+        template<class K>
+        node_pointer _start(const K&, const void*) const {
+            return (_root != _header ? _root : nullptr);
+        }
+
+        /* A lookup ended at pnode */
+        void _remember(node_pointer pnode) const {
+            _remember(pnode, static_cast<node_data*>(nullptr));
+        }
+
+        void _remember(node_pointer pnode, const finger_augment::node_data*) const {
+            _finger = pnode;
+        }
+
+        void _remember(node_pointer, const void*) const {
+        }
+
+        /* Rotates pnode above its parent, in the tree or in a detached subtree */
+        void _rotate_up(node_pointer pnode) {
+            node_pointer parent = pnode->parent;
+            node_pointer grandparent = parent->parent;
+            if (parent->left == pnode) {
+                parent->left = pnode->right;
+                if (pnode->right) {
+                    pnode->right->parent = parent;
+                }
+                pnode->right = parent;
+            } else {
+                parent->right = pnode->left;
+                if (pnode->left) {
+                    pnode->left->parent = parent;
+                }
+                pnode->left = parent;
+            }
+            parent->parent = pnode;
+            pnode->parent = grandparent;
+            if (grandparent) {
+                _replace_child(grandparent, parent, pnode);
+            }
+            _fix_height(parent);
+            _fix_height(pnode);
+        }
+
+        /* Parent of a top node: the header, or nothing in a detached subtree */
+        bool _above_top(node_pointer pnode) const {
+            return (!pnode || pnode == _header);
+        }
+
+        node_pointer _top_of(node_pointer pnode) const {
+            while (pnode->parent) {
+                pnode = pnode->parent;
+            }
+            return pnode;
+        }
+
+        /* Zig-zig and zig-zag steps until pnode is on top */
+        void _splay(node_pointer pnode) {
+            while (!_above_top(pnode->parent)) {
+                node_pointer parent = pnode->parent;
+                if (!_above_top(parent->parent)) {
+                    bool zig_zig = ((parent->parent->left == parent) == (parent->left == pnode));
+                    _rotate_up(zig_zig ? parent : pnode);
+                }
+                _rotate_up(pnode);
+            }
+        }
+
+        /* Address of the node, hashed: fixed for its lifetime and
+         * independent of the keys */
+        static size_type _priority(node_pointer pnode) {
+            unsigned int hash = static_cast<unsigned int>(reinterpret_cast<size_t>(pnode) / sizeof(node_type));
+            hash ^= hash >> 16;
+            hash *= 0x85ebca6bU;
+            hash ^= hash >> 13;
+            hash *= 0xc2b2ae35U;
+            hash ^= hash >> 16;
+            return hash;
+        }
+
+        static bool _is_black(node_pointer pnode) {
+            return (!pnode || pnode->height == red_black_balance::black);
+        }
+
+        /* Black nodes down the left spine, counting pnode */
+        static size_type _black_height(node_pointer pnode) {
+            size_type height = 0;
+            for (; pnode; pnode = pnode->left) {
+                height += _is_black(pnode);
+            }
+            return height;
+        }
+
+        /* Red pnode may have a red parent: recolors upwards, then rotates
+         * twice at most */
+        void _fix_red(node_pointer pnode) {
+            while (true) {
+                node_pointer parent = pnode->parent;
+                if (_above_top(parent)) {
+                    pnode->height = red_black_balance::black;
+                    return;
+                }
+                if (_is_black(parent)) {
+                    return;
+                }
+                node_pointer grandparent = parent->parent;
+                if (_above_top(grandparent)) {
+                    parent->height = red_black_balance::black;
+                    return;
+                }
+                node_pointer uncle = (grandparent->left == parent ? grandparent->right : grandparent->left);
+                if (!_is_black(uncle)) {
+                    parent->height = uncle->height = red_black_balance::black;
+                    grandparent->height = red_black_balance::red;
+                    pnode = grandparent;
+                    continue;
+                }
+                if ((grandparent->left == parent) != (parent->left == pnode)) {
+                    _rotate_up(pnode);
+                    parent = pnode;
+                }
+                _rotate_up(parent);
+                parent->height = red_black_balance::black;
+                grandparent->height = red_black_balance::red;
+                return;
+            }
+        }
+
+        /* Paths through pnode, a child of parent, lack one black node */
+        void _fix_black(node_pointer pnode, node_pointer parent) {
+            while (!_above_top(parent) && _is_black(pnode)) {
+                bool left = (parent->left == pnode);
+                node_pointer sibling = (left ? parent->right : parent->left);
+                if (!_is_black(sibling)) {
+                    sibling->height = red_black_balance::black;
+                    parent->height = red_black_balance::red;
+                    _rotate_up(sibling);
+                    sibling = (left ? parent->right : parent->left);
+                }
+                node_pointer inner = (left ? sibling->left : sibling->right);
+                node_pointer outer = (left ? sibling->right : sibling->left);
+                if (_is_black(inner) && _is_black(outer)) {
+                    sibling->height = red_black_balance::red;
+                    pnode = parent;
+                    parent = pnode->parent;
+                    continue;
+                }
+                if (_is_black(outer)) {
+                    inner->height = red_black_balance::black;
+                    sibling->height = red_black_balance::red;
+                    _rotate_up(inner);
+                    outer = sibling;
+                    sibling = inner;
+                }
+                sibling->height = parent->height;
+                parent->height = red_black_balance::black;
+                outer->height = red_black_balance::black;
+                _rotate_up(sibling);
+                return;
+            }
+            if (pnode) {
+                pnode->height = red_black_balance::black;
+            }
+        }
+
+        /* Thread links, with ft::thread_augment; the others are no-ops */
+        void _thread_insert(node_pointer pnode, const slot_type& slot, const thread_augment::node_data*) {
+            if (slot.parent == _header) {
+                _thread_link(_header, pnode);
+                _thread_link(pnode, _header);
+            } else if (slot.left) {
+                _thread_link(static_cast<node_pointer>(slot.parent->prev), pnode);
+                _thread_link(pnode, slot.parent);
+            } else {
+                _thread_link(pnode, static_cast<node_pointer>(slot.parent->next));
+                _thread_link(slot.parent, pnode);
+            }
+        }
+
+        void _thread_insert(node_pointer, const slot_type&, const void*) {
+        }
+
+        void _thread_unlink(node_pointer pnode, const thread_augment::node_data*) {
+            _thread_link(static_cast<node_pointer>(pnode->prev), static_cast<node_pointer>(pnode->next));
+        }
+
+        void _thread_unlink(node_pointer, const void*) {
+        }
+
+        /* Links the last node of detached lower to the first of detached upper */
+        void _thread_seam(node_pointer lower, node_pointer upper, const thread_augment::node_data*) {
+            if (lower && upper) {
+                _thread_link(_subtree_max(lower), _subtree_min(upper));
+            }
+        }
+
+        void _thread_seam(node_pointer, node_pointer, const void*) {
+        }
+
+        /* Closes the ring through the header */
+        void _thread_ends() {
+            if (_root == _header) {
+                _thread_link(_header, _header);
+            } else {
+                _thread_link(_header, _leftmost);
+                _thread_link(_rightmost, _header);
+            }
+        }
+
+        /* Threads a tree built without links, in one walk through parents */
+        void _thread_all() {
+            node_pointer prev = _header;
+            for (node_pointer pnode = _leftmost; pnode && pnode != _header; pnode = _detached_next(pnode)) {
+                _thread_link(prev, pnode);
+                prev = pnode;
+            }
+            _thread_link(prev, _header);
+        }
+
+        void _thread_link(node_pointer prev, node_pointer next) {
+            _thread_link(prev, next, prev);
+        }
+
+        void _thread_link(node_pointer prev, node_pointer next, const thread_augment::node_data*) {
+            prev->next = next;
+            next->prev = prev;
+        }
+
+        void _thread_link(node_pointer, node_pointer, const void*) {
         }
 
+    private:
+        enum {
+            _short_range = 16,
+            _batch = 16
+        };
+
+        struct _node_compare {
+            compare_type cmp;
+
+            _node_compare(const compare_type& cmp) : cmp(cmp) {
+            }
+
+            bool operator()(node_pointer lhs, node_pointer rhs) const {
+                return cmp(lhs->value, rhs->value);
+            }
+        };
+
     private:
         allocator_type _allocator;
         node_allocator _node_allocator;
+        NodePool<node_type, node_allocator> _pool;
         compare_type _cmp;
         node_pointer _root;
         node_pointer _header;
+        node_pointer _leftmost;
+        node_pointer _rightmost;
         size_type _size;
+        /* Last node a lookup reached, with finger_augment */
+        mutable node_pointer _finger;
+    };
+
+    /* Tree policy for ft::map: the pointer-linked Treap, the default */
+    struct treap_tree {
+        template<class Value, class Compare, class Alloc>
+        struct rebind {
+            typedef Treap<Value, Compare, Alloc> other;
+        };
+    };
+
+    /* Tree policy for ft::map: the Treap with any node augmentation */
+    template<class Augment>
+    struct augmented_tree {
+        template<class Value, class Compare, class Alloc>
+        struct rebind {
+            typedef Treap<Value, Compare, Alloc, Augment> other;
+        };
+    };
+
+    /* Tree policy for ft::map: the Treap with subtree sizes, for nth(), rank(),
+     * count_range() and distance() in O(log n) */
+    struct order_statistic_tree : public augmented_tree<ft::size_augment> {
+    };
+
+    /* Tree policy for ft::map: the Treap with subtree aggregates under
+     * Monoid, for aggregate() in O(log n) */
+    template<class Monoid>
+    struct aggregate_tree : public augmented_tree<ft::monoid_augment<Monoid> > {
+    };
+
+    /* Tree policy for ft::map: the Treap with thread links, for iterator
+     * steps of one load and scans at linked-list speed */
+    struct threaded_tree : public augmented_tree<ft::thread_augment> {
+    };
+
+    /* Tree policy for ft::map: the Treap with finger search, for lookups
+     * near the previous one */
+    struct finger_tree : public augmented_tree<ft::finger_augment> {
+    };
+
+    /* Tree policy for ft::map: the Treap with any balancing policy, and
+     * optionally a node augmentation */
+    template<class Balance, class Augment = ft::no_augment>
+    struct balanced_tree {
+        template<class Value, class Compare, class Alloc>
+        struct rebind {
+            typedef Treap<Value, Compare, Alloc, Augment, Balance> other;
+        };
+    };
+
+    /* Tree policy for ft::map: red-black balancing, fewer rotations on writes */
+    struct red_black_tree : public balanced_tree<ft::red_black_balance> {
+    };
+
+    /* Tree policy for ft::map: a randomized treap */
+    struct randomized_tree : public balanced_tree<ft::treap_balance> {
+    };
+
+    /* Tree policy for ft::map: a splay tree, for skewed lookups */
+    struct splay_tree : public balanced_tree<ft::splay_balance> {
     };
 
 } //namespace ft;
\ No newline at end of file
@@ -0,0 +1,383 @@
+#pragma once
+
+#include "iterators_traits.hpp"
+#include "pair.hpp"
+#include "algorithm.hpp"
+#include "hash.hpp"
+#include "swiss_table.hpp"
+
+#include <functional>
+#include <limits>
+#include <stdexcept>
+
+namespace ft {
+
+    /* Hash map on a ft::SwissTable: elements live inline in one slot array,
+     * with no allocation per element, and lookups probe 16 or 32 control
+     * bytes per instruction. Lookups take the shape of ft::map's. Iterators
+     * are forward only and any insert may invalidate them; erase
+     * invalidates only the erased element's. */
+    template<class Key, class T, class Hash = ft::hash<Key>, class KeyEqual = std::equal_to<Key>,
+             class Alloc = std::allocator<pair<const Key, T> > >
+    class unordered_map {
+    public:
+        typedef Key key_type;
+        typedef T mapped_type;
+        typedef pair<const Key, T> value_type;
+        typedef Hash hasher;
+        typedef KeyEqual key_equal;
+        typedef Alloc allocator_type;
+        typedef typename allocator_type::size_type size_type;
+        typedef typename allocator_type::difference_type difference_type;
+        typedef typename allocator_type::reference reference;
+        typedef typename allocator_type::const_reference const_reference;
+        typedef typename allocator_type::pointer pointer;
+        typedef typename allocator_type::const_pointer const_pointer;
+
+    private:
+        /* Hashes keys and, for rehashing, values by their key */
+        struct pair_hash {
+            hasher hash;
+
+            pair_hash(const hasher& hash) : hash(hash) {
+
+            }
+
+            size_t operator()(const value_type& value) const {
+                return hash(value.first);
+            }
+
+            template<class K>
+            size_t operator()(const K& key) const {
+                return hash(key);
+            }
+        };
+
+        /* Key against value: lookups never build a value_type */
+        struct pair_equal {
+            key_equal eq;
+
+            pair_equal(const key_equal& eq) : eq(eq) {
+
+            }
+
+            bool operator()(const value_type& lhs, const value_type& rhs) const {
+                return eq(lhs.first, rhs.first);
+            }
+
+            template<class K>
+            bool operator()(const K& lhs, const value_type& rhs) const {
+                return eq(lhs, rhs.first);
+            }
+        };
+
+        /* Enables the K overloads of lookups when both hasher and key_equal
+         * are transparent */
+        template<class K, class R>
+        struct _if_transparent : ft::enable_if<ft::is_transparent<hasher>::value
+                                               && ft::is_transparent<key_equal>::value, R> {
+        };
+
+        typedef SwissTable<value_type, pair_hash, pair_equal, allocator_type> table_type;
+        typedef typename table_type::slot_type slot_type;
+
+    public:
+        typedef typename table_type::iterator iterator;
+        typedef typename table_type::const_iterator const_iterator;
+
+    public:
+        explicit unordered_map(size_type bucket_count = 0, const hasher& hash = hasher(), const key_equal& equal = key_equal(),
+                               const allocator_type& alloc = allocator_type()) : _table(hash, equal, alloc) {
+            _table.reserve(bucket_count);
+        }
+
+        template< class InputIt >
+        unordered_map( InputIt first, InputIt last, size_type bucket_count = 0, const hasher& hash = hasher(),
+                       const key_equal& equal = key_equal(), const allocator_type& alloc = allocator_type() ) : _table(hash, equal, alloc) {
+            _table.reserve(bucket_count);
+            insert(first, last);
+        }
+
+        unordered_map(const unordered_map& other) : _table(other._table) {
+
+        }
+
+        unordered_map& operator=(const unordered_map& other) {
+            if (this != &other) {
+                _table = other._table;
+            }
+            return *this;
+        }
+
+        allocator_type get_allocator() const {
+            return _table.get_allocator();
+        }
+
+        ~unordered_map() {
+
+        }
+
+    /* Element access */
+    public:
+        mapped_type& at(const key_type& key) {
+            iterator it = _table.find(key);
+            if (it == end()) {
+                throw std::out_of_range("No such element");
+            } else {
+                return it->second;
+            }
+        }
+
+        const mapped_type& at(const key_type& key) const {
+            const_iterator it = _table.find(key);
+            if (it == end()) {
+                throw std::out_of_range("No such element");
+            } else {
+                return it->second;
+            }
+        }
+
+        mapped_type& operator[](const key_type& key) {
+            return try_emplace(key).first->second;
+        }
+
+    /* Iterators */
+    public:
+        iterator begin() {
+            return _table.begin();
+        }
+
+        const_iterator begin() const {
+            return _table.begin();
+        }
+
+        iterator end() {
+            return _table.end();
+        }
+
+        const_iterator end() const {
+            return _table.end();
+        }
+
+    /* Capacity */
+    public:
+        size_type size() const {
+            return _table.size();
+        }
+
+        bool empty() const {
+            return (_table.size() == 0);
+        }
+
+        size_type max_size() const {
+            return std::numeric_limits<difference_type>::max() / sizeof(value_type);
+        }
+
+    /* Modifiers */
+    public:
+        void clear() {
+            _table.clear();
+        }
+
+        ft::pair<iterator, bool> insert(const value_type& value) {
+            return _table.insert(value);
+        }
+
+        /* The hint is of no use to a hash table */
+        iterator insert(const_iterator hint, const value_type& value) {
+            (void)hint;
+            return _table.insert(value).first;
+        }
+
+        template< class InputIt >
+        void insert( InputIt first, InputIt last ) {
+            for (; first != last; ++first) {
+                _table.insert(*first);
+            }
+        }
+
+        ft::pair<iterator, bool> try_emplace(const key_type& key) {
+            slot_type slot;
+            iterator it = _table.locate(key, slot);
+            if (it != end()) {
+                return ft::make_pair(it, false);
+            } else {
+                return ft::make_pair(_table.insert_at(slot, value_type(key, mapped_type())), true);
+            }
+        }
+
+        ft::pair<iterator, bool> try_emplace(const key_type& key, const mapped_type& obj) {
+            slot_type slot;
+            iterator it = _table.locate(key, slot);
+            if (it != end()) {
+                return ft::make_pair(it, false);
+            } else {
+                return ft::make_pair(_table.insert_at(slot, value_type(key, obj)), true);
+            }
+        }
+
+        ft::pair<iterator, bool> insert_or_assign(const key_type& key, const mapped_type& obj) {
+            slot_type slot;
+            iterator it = _table.locate(key, slot);
+            if (it != end()) {
+                it->second = obj;
+                return ft::make_pair(it, false);
+            } else {
+                return ft::make_pair(_table.insert_at(slot, value_type(key, obj)), true);
+            }
+        }
+
+        /* Returns the iterator following pos */
+        iterator erase(const_iterator pos) {
+            return _table.erase(_mutable(pos));
+        }
+
+        iterator erase(const_iterator first, const_iterator last) {
+            return _table.erase(_mutable(first), _mutable(last));
+        }
+
+        size_type erase(const key_type& key) {
+            iterator it = _table.find(key);
+            if (it == end()) {
+                return 0;
+            } else {
+                _table.erase(it);
+                return 1;
+            }
+        }
+
+        void swap(unordered_map& other) {
+            _table.swap(other._table);
+        }
+
+    /* Lookup */
+    public:
+        size_type count(const key_type& key) const {
+            return (_table.find(key) != end() ? 1 : 0);
+        }
+
+        template<class K>
+        typename _if_transparent<K, size_type>::type count(const K& key) const {
+            return (_table.find(key) != end() ? 1 : 0);
+        }
+
+        iterator find(const key_type& key) {
+            return _table.find(key);
+        }
+
+        const_iterator find(const key_type& key) const {
+            return _table.find(key);
+        }
+
+        template<class K>
+        typename _if_transparent<K, iterator>::type find(const K& key) {
+            return _table.find(key);
+        }
+
+        template<class K>
+        typename _if_transparent<K, const_iterator>::type find(const K& key) const {
+            return _table.find(key);
+        }
+
+        ft::pair<iterator, iterator> equal_range(const key_type& key) {
+            return _range(_table.find(key), end());
+        }
+
+        ft::pair<const_iterator, const_iterator> equal_range(const key_type& key) const {
+            return _range(_table.find(key), end());
+        }
+
+        template<class K>
+        typename _if_transparent<K, ft::pair<iterator, iterator> >::type equal_range(const K& key) {
+            return _range(_table.find(key), end());
+        }
+
+        template<class K>
+        typename _if_transparent<K, ft::pair<const_iterator, const_iterator> >::type equal_range(const K& key) const {
+            return _range(_table.find(key), end());
+        }
+
+    /* Hash policy. A bucket is a slot here: the table holds up to 7/8 of
+     * bucket_count() elements before it doubles. */
+    public:
+        size_type bucket_count() const {
+            return _table.capacity();
+        }
+
+        float load_factor() const {
+            return (bucket_count() ? float(size()) / bucket_count() : 0.0f);
+        }
+
+        float max_load_factor() const {
+            return 0.875f;
+        }
+
+        /* Resizes to fit count elements at once, or shrinks to fit with 0 */
+        void rehash(size_type count) {
+            _table.rehash(count);
+        }
+
+        /* Makes room for count elements in one resize */
+        void reserve(size_type count) {
+            _table.reserve(count);
+        }
+
+    /* Observers */
+    public:
+        hasher hash_function() const {
+            return _table.hash_function().hash;
+        }
+
+        key_equal key_eq() const {
+            return _table.key_eq().eq;
+        }
+
+    /* private helpers */
+    private:
+        iterator _mutable(const_iterator pos) {
+            return iterator(pos.ctrl_base(), const_cast<value_type*>(pos.base()));
+        }
+
+        template<class It>
+        static ft::pair<It, It> _range(It it, It end) {
+            It last = it;
+            if (it != end) {
+                ++last;
+            }
+            return ft::make_pair(it, last);
+        }
+
+    private:
+        table_type _table;
+
+    };
+
+    /* Same elements, in any order */
+    template< class Key, class T, class Hash, class KeyEqual, class Alloc >
+    bool operator==(const ft::unordered_map<Key, T, Hash, KeyEqual, Alloc>& lhs,
+                    const ft::unordered_map<Key, T, Hash, KeyEqual, Alloc>& rhs ) {
+        if (lhs.size() != rhs.size()) {
+            return false;
+        }
+        typedef typename ft::unordered_map<Key, T, Hash, KeyEqual, Alloc>::const_iterator const_iterator;
+        for (const_iterator it = lhs.begin(); it != lhs.end(); ++it) {
+            const_iterator other = rhs.find(it->first);
+            if (other == rhs.end() || !(other->second == it->second)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    template< class Key, class T, class Hash, class KeyEqual, class Alloc >
+    bool operator!=(const ft::unordered_map<Key, T, Hash, KeyEqual, Alloc>& lhs,
+                    const ft::unordered_map<Key, T, Hash, KeyEqual, Alloc>& rhs ) {
+        return !(lhs == rhs);
+    }
+
+    template< class Key, class T, class Hash, class KeyEqual, class Alloc >
+    void swap(ft::unordered_map<Key, T, Hash, KeyEqual, Alloc>& lhs, ft::unordered_map<Key, T, Hash, KeyEqual, Alloc>& rhs) {
+        lhs.swap(rhs);
+    }
+
+} //namespace ft
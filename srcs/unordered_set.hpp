@@ -0,0 +1,251 @@
+#pragma once
+
+#include "iterators_traits.hpp"
+#include "pair.hpp"
+#include "algorithm.hpp"
+#include "hash.hpp"
+#include "swiss_table.hpp"
+
+#include <functional>
+#include <limits>
+
+namespace ft {
+
+    /* Hash set on a ft::SwissTable, as ft::unordered_map. Keys cannot be
+     * modified through iterators. */
+    template<class Key, class Hash = ft::hash<Key>, class KeyEqual = std::equal_to<Key>, class Alloc = std::allocator<Key> >
+    class unordered_set {
+    public:
+        typedef Key key_type;
+        typedef Key value_type;
+        typedef Hash hasher;
+        typedef KeyEqual key_equal;
+        typedef Alloc allocator_type;
+        typedef typename allocator_type::size_type size_type;
+        typedef typename allocator_type::difference_type difference_type;
+        typedef typename allocator_type::const_reference reference;
+        typedef typename allocator_type::const_reference const_reference;
+        typedef typename allocator_type::const_pointer pointer;
+        typedef typename allocator_type::const_pointer const_pointer;
+
+    private:
+        /* Enables the K overloads of lookups when both hasher and key_equal
+         * are transparent */
+        template<class K, class R>
+        struct _if_transparent : ft::enable_if<ft::is_transparent<hasher>::value
+                                               && ft::is_transparent<key_equal>::value, R> {
+        };
+
+        typedef SwissTable<value_type, hasher, key_equal, allocator_type> table_type;
+
+    public:
+        typedef typename table_type::const_iterator iterator;
+        typedef typename table_type::const_iterator const_iterator;
+
+    public:
+        explicit unordered_set(size_type bucket_count = 0, const hasher& hash = hasher(), const key_equal& equal = key_equal(),
+                               const allocator_type& alloc = allocator_type()) : _table(hash, equal, alloc) {
+            _table.reserve(bucket_count);
+        }
+
+        template< class InputIt >
+        unordered_set( InputIt first, InputIt last, size_type bucket_count = 0, const hasher& hash = hasher(),
+                       const key_equal& equal = key_equal(), const allocator_type& alloc = allocator_type() ) : _table(hash, equal, alloc) {
+            _table.reserve(bucket_count);
+            insert(first, last);
+        }
+
+        unordered_set(const unordered_set& other) : _table(other._table) {
+        }
+
+        unordered_set& operator=(const unordered_set& other) {
+            if (this != &other) {
+                _table = other._table;
+            }
+            return *this;
+        }
+
+        allocator_type get_allocator() const {
+            return _table.get_allocator();
+        }
+
+        ~unordered_set() {
+        }
+
+    /* Iterators */
+    public:
+        const_iterator begin() const {
+            return _table.begin();
+        }
+
+        const_iterator end() const {
+            return _table.end();
+        }
+
+    /* Capacity */
+    public:
+        size_type size() const {
+            return _table.size();
+        }
+
+        bool empty() const {
+            return (_table.size() == 0);
+        }
+
+        size_type max_size() const {
+            return std::numeric_limits<difference_type>::max() / sizeof(value_type);
+        }
+
+    /* Modifiers */
+    public:
+        void clear() {
+            _table.clear();
+        }
+
+        ft::pair<iterator, bool> insert(const value_type& value) {
+            ft::pair<typename table_type::iterator, bool> result = _table.insert(value);
+            return ft::make_pair(iterator(result.first), result.second);
+        }
+
+        /* The hint is of no use to a hash table */
+        iterator insert(const_iterator hint, const value_type& value) {
+            (void)hint;
+            return _table.insert(value).first;
+        }
+
+        template< class InputIt >
+        void insert( InputIt first, InputIt last ) {
+            for (; first != last; ++first) {
+                _table.insert(*first);
+            }
+        }
+
+        /* Returns the iterator following pos */
+        iterator erase(const_iterator pos) {
+            return _table.erase(_mutable(pos));
+        }
+
+        iterator erase(const_iterator first, const_iterator last) {
+            return _table.erase(_mutable(first), _mutable(last));
+        }
+
+        size_type erase(const key_type& key) {
+            typename table_type::iterator it = _table.find(key);
+            if (it == _table.end()) {
+                return 0;
+            }
+            _table.erase(it);
+            return 1;
+        }
+
+        void swap(unordered_set& other) {
+            _table.swap(other._table);
+        }
+
+    /* Lookup */
+    public:
+        size_type count(const key_type& key) const {
+            return (_table.find(key) != end() ? 1 : 0);
+        }
+
+        template<class K>
+        typename _if_transparent<K, size_type>::type count(const K& key) const {
+            return (_table.find(key) != end() ? 1 : 0);
+        }
+
+        const_iterator find(const key_type& key) const {
+            return _table.find(key);
+        }
+
+        template<class K>
+        typename _if_transparent<K, const_iterator>::type find(const K& key) const {
+            return _table.find(key);
+        }
+
+        ft::pair<const_iterator, const_iterator> equal_range(const key_type& key) const {
+            return _range(_table.find(key));
+        }
+
+        template<class K>
+        typename _if_transparent<K, ft::pair<const_iterator, const_iterator> >::type equal_range(const K& key) const {
+            return _range(_table.find(key));
+        }
+
+    /* Hash policy, as ft::unordered_map's */
+    public:
+        size_type bucket_count() const {
+            return _table.capacity();
+        }
+
+        float load_factor() const {
+            return (bucket_count() ? float(size()) / bucket_count() : 0.0f);
+        }
+
+        float max_load_factor() const {
+            return 0.875f;
+        }
+
+        void rehash(size_type count) {
+            _table.rehash(count);
+        }
+
+        void reserve(size_type count) {
+            _table.reserve(count);
+        }
+
+    /* Observers */
+    public:
+        hasher hash_function() const {
+            return _table.hash_function();
+        }
+
+        key_equal key_eq() const {
+            return _table.key_eq();
+        }
+
+    /* private helpers */
+    private:
+        typename table_type::iterator _mutable(const_iterator pos) {
+            return typename table_type::iterator(pos.ctrl_base(), const_cast<value_type*>(pos.base()));
+        }
+
+        ft::pair<const_iterator, const_iterator> _range(const_iterator it) const {
+            const_iterator last = it;
+            if (it != end()) {
+                ++last;
+            }
+            return ft::make_pair(it, last);
+        }
+
+    private:
+        table_type _table;
+    };
+
+    /* Same keys, in any order */
+    template< class Key, class Hash, class KeyEqual, class Alloc >
+    bool operator==(const ft::unordered_set<Key, Hash, KeyEqual, Alloc>& lhs,
+                    const ft::unordered_set<Key, Hash, KeyEqual, Alloc>& rhs) {
+        if (lhs.size() != rhs.size()) {
+            return false;
+        }
+        typedef typename ft::unordered_set<Key, Hash, KeyEqual, Alloc>::const_iterator const_iterator;
+        for (const_iterator it = lhs.begin(); it != lhs.end(); ++it) {
+            if (rhs.find(*it) == rhs.end()) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    template< class Key, class Hash, class KeyEqual, class Alloc >
+    bool operator!=(const ft::unordered_set<Key, Hash, KeyEqual, Alloc>& lhs,
+                    const ft::unordered_set<Key, Hash, KeyEqual, Alloc>& rhs) {
+        return !(lhs == rhs);
+    }
+
+    template< class Key, class Hash, class KeyEqual, class Alloc >
+    void swap(ft::unordered_set<Key, Hash, KeyEqual, Alloc>& lhs, ft::unordered_set<Key, Hash, KeyEqual, Alloc>& rhs) {
+        lhs.swap(rhs);
+    }
+
+} //namespace ft
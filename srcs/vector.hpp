@@ -1,6 +1,6 @@
 #pragma once
 
-#include <i386/limits.h>
+#include <climits>
 #include <iostream>
 #include <limits>
 #include <vector>
@@ -47,7 +47,7 @@ namespace ft {
             }
 
             vector(const vector& oth) : _size(oth._size), _capacity(oth._capacity), _allocator(oth._allocator) {
-                _begin = _allocator.allocate(_capacity);
+                _begin = (_capacity ? _allocator.allocate(_capacity) : pointer());
                 _end = _begin + _size;
                 for (size_type i = 0; i < oth._size; i++) {
                     _allocator.construct(_begin + i, oth[i]);
@@ -71,11 +71,12 @@ namespace ft {
             vector& operator=(const vector& oth) {
                 if (this != &oth) {
                     clear();
+                    _allocator.deallocate(_begin, _capacity);
                     _size = oth._size;
                     _capacity = oth._capacity;
                     _allocator = oth._allocator;
 
-                    _begin = _allocator.allocate(_capacity);
+                    _begin = (_capacity ? _allocator.allocate(_capacity) : pointer());
                     _end = _begin + _size;
                     for (size_type i = 0; i < _size; i++) {
                         _allocator.construct(_begin + i, oth[i]);
@@ -241,14 +242,18 @@ namespace ft {
 
             iterator insert( iterator pos, const T& value ) {
                 size_type index = pos - begin();
+                value_type copy(value);
                 _reallocate(_size + 1);
-                _resize(_size + 1);
-                size_t i = _size - 1;
-                while (i > index) {
-                    _allocator.construct(_begin + i, *(_begin + i - 1));
-                    --i;
+                if (index == _size) {
+                    _allocator.construct(_end, copy);
+                } else {
+                    _allocator.construct(_end, *(_end - 1));
+                    for (size_type i = _size - 1; i > index; --i) {
+                        _begin[i] = _begin[i - 1];
+                    }
+                    _begin[index] = copy;
                 }
-                _allocator.construct(_begin + i, value);
+                _resize(_size + 1);
                 return iterator(_begin + index);
             }
 
@@ -290,26 +295,23 @@ namespace ft {
             }
 
             iterator erase( iterator pos ) {
-                iterator ret = (pos != end() ? pos : end());
-
-                while (pos != end()) {
-                    *pos = *(pos + 1);
-                    ++pos;
+                if (pos == end()) {
+                    return pos;
                 }
-                if (ret != end()) {
-                    _resize(_size - 1);
-                }
-                return ret;
+                return erase(pos, pos + 1);
             }
 
+            /* Moves the tail down over the gap and destroys what is left past the new end */
             iterator erase( iterator first, iterator last ) {
-                if (first <= last) {
+                if (first < last) {
                     size_t count = last - first;
                     size_t index = first - begin();
 
-                    while(first != end()) {
-                        *first = *(first + count);
-                        ++first;
+                    for (pointer p = _begin + index; p + count < _end; ++p) {
+                        *p = *(p + count);
+                    }
+                    for (pointer p = _end - count; p != _end; ++p) {
+                        _allocator.destroy(p);
                     }
                     _resize(_size - count);
                     return begin() + index;
@@ -318,13 +320,19 @@ namespace ft {
             }
 
             void push_back( const T& value ) {
-                _reallocate(_size + 1);
+                if (_size == _capacity) {
+                    value_type copy(value);
+                    _reallocate(_size + 1);
+                    _allocator.construct(_end, copy);
+                } else {
+                    _allocator.construct(_end, value);
+                }
                 _resize(_size + 1);
-                back() = value;
             }
 
             void pop_back() {
                 if (_size) {
+                    _allocator.destroy(_end - 1);
                     _resize(_size - 1);
                 }
             }
@@ -356,7 +364,7 @@ namespace ft {
         /* private utility */
         private:
             void _reallocate(size_t size) {
-                if (size < _capacity) {
+                if (size <= _capacity) {
                     return ;
                 }
                 size_type oldCapacity = _capacity;